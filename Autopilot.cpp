@@ -0,0 +1,260 @@
+// Autopilot.cpp
+#include "Autopilot.h"
+#include "Constants.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+// Constante de exploración de UCT (recompensas en [0, 1])
+static constexpr float UCT_C = 0.7f;
+
+// Acción i <-> Direction(i + 1) <-> bit i de la máscara de salidas
+static Direction actionDirection(int action) {
+    return static_cast<Direction>(action + 1);
+}
+
+Autopilot::Autopilot(const AutopilotConfig& cfg) : config(cfg), pool(cfg.threads) {
+    for (int i = 0; i < pool.size(); i++) {
+        std::unique_ptr<Worker> w(new Worker());
+        w->nodes.resize(MAX_NODES);
+        workers.push_back(std::move(w));
+    }
+}
+
+Autopilot::~Autopilot() = default;
+
+Direction Autopilot::decide(const GameCore& core) {
+    if (core.getState() != GameState::Playing)
+        return Direction::None;
+    
+    const PacMan& pacman = core.getPacman();
+    bool newTile = pacman.getTileX() != lastTileX || pacman.getTileY() != lastTileY;
+    if (!newTile && pacman.direction != Direction::None)
+        return Direction::None;
+    
+    lastTileX = pacman.getTileX();
+    lastTileY = pacman.getTileY();
+    
+    // Preparar la búsqueda
+    core.save(root);
+    rootScore = core.getScore();
+    
+    auto start = std::chrono::steady_clock::now();
+    deadline = start + std::chrono::microseconds(static_cast<long>(config.budgetMs * 1000.0f));
+    
+    uint64_t hash = core.getHash();
+    for (size_t i = 0; i < workers.size(); i++) {
+        // Semilla fija por estado y hilo: con maxRollouts la decisión es reproducible
+        workers[i]->rng.setState(static_cast<uint32_t>(hash ^ (hash >> 32)) + static_cast<uint32_t>(i) * 0x9E3779B9u);
+    }
+    
+    {
+        PROFILE_ZONE("Autopilot::search");
+        // Los rollouts del worker 0 no se graban en el buffer de este hilo
+        PROFILE_SUSPEND();
+        pool.run([this](int index) { search(*workers[index]); });
+    }
+    
+    totalSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    // Sumar las visitas de la raíz de todos los árboles
+    uint32_t visits[4] = {};
+    for (const std::unique_ptr<Worker>& w : workers) {
+        totalRollouts += w->rollouts;
+        const Node& r = w->nodes[0];
+        for (int a = 0; a < 4; a++) {
+            if (r.children[a] >= 0) visits[a] += w->nodes[r.children[a]].visits;
+        }
+    }
+    
+    int best = -1;
+    for (int a = 0; a < 4; a++) {
+        if (visits[a] > 0 && (best < 0 || visits[a] > visits[best])) best = a;
+    }
+    return best >= 0 ? actionDirection(best) : Direction::None;
+}
+
+void Autopilot::search(Worker& w) {
+    w.rollouts = 0;
+    w.sim.restore(root);
+    
+    Node& r = w.nodes[0];
+    r.state = root;
+    std::fill(r.children, r.children + 4, -1);
+    r.parent = -1;
+    r.visits = 0;
+    r.value = 0.0f;
+    r.legal = legalActions(w.sim);
+    r.outcome = Outcome::Running;
+    w.nodeCount = 1;
+    
+    bool timed = config.budgetMs > 0.0f;
+    if (!timed && config.maxRollouts <= 0)
+        return;
+    
+    for (;;) {
+        if (config.maxRollouts > 0 && w.rollouts >= static_cast<uint64_t>(config.maxRollouts))
+            break;
+        // Mirar el reloj cada 8 rollouts
+        if (timed && (w.rollouts & 7) == 0 && std::chrono::steady_clock::now() >= deadline)
+            break;
+        
+        // Selección: bajar por UCT mientras el nodo esté completamente expandido
+        int node = 0;
+        int action = -1;
+        for (;;) {
+            const Node& n = w.nodes[node];
+            if (n.outcome != Outcome::Running)
+                break;
+            
+            float logN = std::log(static_cast<float>(n.visits + 1));
+            float bestScore = -1.0f;
+            int bestAction = -1;
+            bool unexpanded = false;
+            for (int a = 0; a < 4; a++) {
+                if (!(n.legal & (1 << a)))
+                    continue;
+                if (n.children[a] < 0) {
+                    bestAction = a;
+                    unexpanded = true;
+                    break;
+                }
+                const Node& c = w.nodes[n.children[a]];
+                float score = c.value / c.visits + UCT_C * std::sqrt(logN / c.visits);
+                if (score > bestScore) {
+                    bestScore = score;
+                    bestAction = a;
+                }
+            }
+            
+            if (bestAction < 0)
+                break;
+            if (unexpanded) {
+                action = bestAction;
+                break;
+            }
+            node = n.children[bestAction];
+        }
+        
+        // Expansión (si queda espacio); si no, el rollout sale de la hoja
+        if (action >= 0 && w.nodeCount < MAX_NODES) {
+            node = expand(w, node, action);
+        } else {
+            w.sim.restore(w.nodes[node].state);
+        }
+        
+        float reward = rollout(w, w.nodes[node].outcome);
+        w.rollouts++;
+        
+        // Retropropagación
+        for (int n = node; n >= 0; n = w.nodes[n].parent) {
+            w.nodes[n].visits++;
+            w.nodes[n].value += reward;
+        }
+    }
+}
+
+int Autopilot::expand(Worker& w, int parent, int action) {
+    w.sim.restore(w.nodes[parent].state);
+    Outcome outcome = step(w.sim, actionDirection(action));
+    
+    int index = w.nodeCount++;
+    Node& n = w.nodes[index];
+    w.sim.save(n.state);
+    std::fill(n.children, n.children + 4, -1);
+    n.parent = parent;
+    n.visits = 0;
+    n.value = 0.0f;
+    n.legal = legalActions(w.sim);
+    n.outcome = outcome;
+    
+    w.nodes[parent].children[action] = index;
+    return index;
+}
+
+float Autopilot::rollout(Worker& w, Outcome outcome) {
+    // Pasos al azar (sin volver atrás salvo que no haya otra salida)
+    for (int i = 0; i < ROLLOUT_STEPS && outcome == Outcome::Running; i++) {
+        uint8_t legal = legalActions(w.sim);
+        uint8_t back = directionBit(oppositeDirection(w.sim.getPacman().direction));
+        if (legal & ~back) legal &= ~back;
+        
+        int action = 0;
+        int start = static_cast<int>(w.rng.next() & 3);
+        for (int k = 0; k < 4; k++) {
+            int a = (start + k) & 3;
+            if (legal & (1 << a)) {
+                action = a;
+                break;
+            }
+        }
+        outcome = step(w.sim, actionDirection(action));
+    }
+    return evaluate(w.sim, outcome);
+}
+
+float Autopilot::evaluate(const GameCore& sim, Outcome outcome) const {
+    if (outcome == Outcome::Dead)
+        return 0.0f;
+    if (outcome == Outcome::Cleared)
+        return 1.0f;
+    
+    // Puntos ganados desde la raíz (saturando) y cercanía al dot más próximo
+    float points = static_cast<float>(sim.getScore() - rootScore);
+    float gain = points / (points + 300.0f);
+    
+    const Map& map = sim.getMap();
+    const PacMan& pacman = sim.getPacman();
+    int nearest = 40;
+    auto closer = [&](int x, int y) {
+        int d = map.getPathDistance(pacman.getTileX(), pacman.getTileY(), x, y);
+        if (d >= 0 && d < nearest) nearest = d;
+    };
+    map.forEachDot(closer);
+    map.forEachPowerPellet(closer);
+    float proximity = 1.0f - nearest / 40.0f;
+    
+    return 0.2f + 0.6f * gain + 0.2f * proximity;
+}
+
+Autopilot::Outcome Autopilot::step(GameCore& sim, Direction dir) {
+    sim.setDesiredDirection(dir);
+    
+    const PacMan& pacman = sim.getPacman();
+    int startX = pacman.getTileX();
+    int startY = pacman.getTileY();
+    
+    Outcome outcome = Outcome::Running;
+    for (int t = 0; t < MAX_STEP_TICKS; t++) {
+        sim.update();
+        
+        GameState state = sim.getState();
+        if (state == GameState::LevelClear) {
+            outcome = Outcome::Cleared;
+            break;
+        }
+        if (state != GameState::Playing && state != GameState::GhostEaten) {
+            outcome = Outcome::Dead;
+            break;
+        }
+        if (state == GameState::GhostEaten)
+            continue;
+        
+        // El paso termina en el próximo cruce o contra una pared
+        bool moved = pacman.getTileX() != startX || pacman.getTileY() != startY;
+        if (moved && sim.getMap().isIntersection(pacman.getTileX(), pacman.getTileY()))
+            break;
+        if (pacman.direction == Direction::None)
+            break;
+    }
+    
+    // Nadie consume los eventos de la simulación del árbol
+    sim.getEvents().clear();
+    return outcome;
+}
+
+uint8_t Autopilot::legalActions(const GameCore& sim) {
+    const PacMan& pacman = sim.getPacman();
+    uint8_t legal = sim.getMap().getExits(pacman.getTileX(), pacman.getTileY(), false) & EXIT_MASK;
+    return legal ? legal : static_cast<uint8_t>(EXIT_MASK);
+}
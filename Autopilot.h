@@ -0,0 +1,90 @@
+// Autopilot.h
+// Piloto automático de Pac-Man: MCTS sobre la simulación real (GameCore)
+#pragma once
+
+#include "GameCore.h"
+#include "GameSnapshot.h"
+#include "GameRandom.h"
+#include "WorkerPool.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct AutopilotConfig {
+    int threads = 0;          // 0 = un hilo por núcleo
+    float budgetMs = 5.0f;    // Tiempo por decisión (0 = sin límite de tiempo)
+    int maxRollouts = 0;      // Rollouts por hilo y decisión (0 = sin límite)
+};
+
+// Cada hilo arma su propio árbol desde el mismo estado (paralelismo de raíz,
+// sin locks) y al final se suman las visitas de las jugadas de la raíz.
+// Un paso del árbol es una dirección hasta el próximo cruce; los nodos
+// guardan un GameSnapshot y se expanden con GameCore::restore + update.
+// Con budgetMs = 0 y maxRollouts > 0 las decisiones son deterministas.
+class Autopilot {
+public:
+    explicit Autopilot(const AutopilotConfig& config = AutopilotConfig());
+    ~Autopilot();
+    
+    Autopilot(const Autopilot&) = delete;
+    Autopilot& operator=(const Autopilot&) = delete;
+    
+    // Dirección a tomar. Solo piensa cuando Pac-Man entra a un tile nuevo
+    // (o está detenido) en estado Playing; si no, devuelve None.
+    Direction decide(const GameCore& core);
+    
+    // Rendimiento acumulado (para seguir la velocidad del núcleo)
+    uint64_t getRollouts() const { return totalRollouts; }
+    double getSearchSeconds() const { return totalSeconds; }
+    double getRolloutsPerSecond() const { return totalSeconds > 0.0 ? totalRollouts / totalSeconds : 0.0; }
+    int getThreadCount() const { return pool.size(); }
+
+private:
+    static constexpr int MAX_NODES = 2048;       // Por hilo
+    static constexpr int ROLLOUT_STEPS = 6;      // Pasos aleatorios después de la hoja
+    static constexpr int MAX_STEP_TICKS = 48;    // Tope de un paso (ticks)
+    
+    enum class Outcome : uint8_t { Running, Dead, Cleared };
+    
+    struct Node {
+        GameSnapshot state;      // Estado al llegar al nodo
+        int32_t children[4];     // Por dirección (Up, Down, Left, Right); -1 = sin expandir
+        int32_t parent;
+        uint32_t visits;
+        float value;             // Suma de recompensas
+        uint8_t legal;           // Bits de las direcciones con salida
+        Outcome outcome;
+    };
+    
+    struct Worker {
+        GameCore sim;
+        std::vector<Node> nodes;  // Reservado una vez (MAX_NODES)
+        int nodeCount = 0;
+        GameRandom rng;
+        uint64_t rollouts = 0;
+    };
+    
+    AutopilotConfig config;
+    WorkerPool pool;
+    std::vector<std::unique_ptr<Worker>> workers;  // Uno por worker del pool
+    
+    // Búsqueda en curso (la escribe decide() antes de despertar a los hilos)
+    GameSnapshot root;
+    int rootScore = 0;
+    std::chrono::steady_clock::time_point deadline;
+    
+    // Último tile en que se decidió
+    int lastTileX = -100;
+    int lastTileY = -100;
+    
+    uint64_t totalRollouts = 0;
+    double totalSeconds = 0.0;
+    
+    void search(Worker& w);
+    int expand(Worker& w, int parent, int action);
+    float rollout(Worker& w, Outcome outcome);
+    float evaluate(const GameCore& sim, Outcome outcome) const;
+    static Outcome step(GameCore& sim, Direction dir);
+    static uint8_t legalActions(const GameCore& sim);
+};
@@ -0,0 +1,291 @@
+// Bench.cpp
+// Microbenchmarks de las funciones calientes (target pacman_bench).
+// Entradas fijas: semilla fija, tiles pseudoaleatorios con semilla fija y
+// estados tomados de una partida headless determinista.
+#include "GameCore.h"
+#include "GhostAI.h"
+#include "Map.h"
+#include "Renderer.h"
+#include "TextureManager.h"
+#include "Constants.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+// ===== CONTEO DE ASIGNACIONES =====
+
+static std::atomic<uint64_t> allocationCount{0};
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+// ===== HARNESS =====
+
+// Evita que el compilador descarte resultados
+template <typename T>
+volatile T benchSink;
+
+template <typename T>
+static void keep(T value) {
+    benchSink<T> = value;
+}
+
+static const char* benchFilter = nullptr;
+
+static bool selected(const char* name) {
+    return !benchFilter || std::strstr(name, benchFilter);
+}
+
+// fn() es una operación. Se calibra la cantidad de iteraciones para que
+// cada corrida dure ~20 ms y se reporta la mediana de 5 corridas.
+template <typename Fn>
+static void bench(const char* name, Fn&& fn) {
+    if (!selected(name))
+        return;
+    
+    using Clock = std::chrono::steady_clock;
+    
+    uint64_t iterations = 1;
+    for (;;) {
+        auto start = Clock::now();
+        for (uint64_t i = 0; i < iterations; i++) fn();
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (ms >= 20.0 || iterations >= (1ull << 30)) break;
+        iterations *= 2;
+    }
+    
+    double runs[5];
+    uint64_t allocsBefore = allocationCount.load();
+    for (double& run : runs) {
+        auto start = Clock::now();
+        for (uint64_t i = 0; i < iterations; i++) fn();
+        run = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+    }
+    uint64_t allocs = allocationCount.load() - allocsBefore;
+    
+    std::sort(runs, runs + 5);
+    std::printf("%-34s %12.2f ns/op %10.3f allocs/op  (min %.2f, max %.2f)\n",
+                name, runs[2], static_cast<double>(allocs) / (5.0 * iterations), runs[0], runs[4]);
+}
+
+// Métodos privados medidos por separado (friend de GameCore y Ghost)
+struct BenchAccess {
+    static void checkCollisions(GameCore& core) { core.checkCollisions(); }
+    static Direction chooseDirection(const Ghost& ghost, const Map& map) { return ghost.chooseDirection(map); }
+};
+
+// ===== ENTRADAS =====
+
+// Tiles pseudoaleatorios (incluye el borde fuera del mapa)
+static std::vector<std::pair<int, int>> makeTiles(int count) {
+    GameRandom rng(12345);
+    std::vector<std::pair<int, int>> tiles;
+    for (int i = 0; i < count; i++) {
+        int x = static_cast<int>(rng.next() % (MAP_WIDTH + 2)) - 1;
+        int y = static_cast<int>(rng.next() % (MAP_HEIGHT + 2)) - 1;
+        tiles.emplace_back(x, y);
+    }
+    return tiles;
+}
+
+// Misma política que el modo headless: girar al chocar con una pared
+static void stepHeadless(GameCore& core, int& turn) {
+    static const Direction turns[] = {Direction::Up, Direction::Left, Direction::Down, Direction::Right};
+    if (core.getState() == GameState::Playing && core.getPacman().direction == Direction::None) {
+        turn = (turn + 1) % 4;
+        core.setDesiredDirection(turns[turn]);
+    }
+    core.update();
+    core.getEvents().clear();
+    if (core.getState() == GameState::GameOver) {
+        core.newGame();
+    }
+}
+
+// Partida en Playing a mitad de nivel
+static void warmUp(GameCore& core) {
+    core.startGame();
+    int turn = 0;
+    for (int i = 0; i < 1500 || core.getState() != GameState::Playing; i++) {
+        stepHeadless(core, turn);
+    }
+}
+
+// ===== MAIN =====
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) benchFilter = argv[1];
+    
+    GameCore core;
+    warmUp(core);
+    GameSnapshot playing;
+    core.save(playing);
+    
+    std::printf("pacman_bench (filtro: %s)\n\n", benchFilter ? benchFilter : "ninguno");
+    
+    // --- Mapa ---
+    {
+        const Map& map = core.getMap();
+        std::vector<std::pair<int, int>> tiles = makeTiles(1024);
+        size_t i = 0;
+        
+        bench("Map::isWalkable", [&] {
+            const auto& t = tiles[i++ & 1023];
+            keep(map.isWalkable(t.first, t.second, false));
+        });
+        bench("Map::isIntersection", [&] {
+            const auto& t = tiles[i++ & 1023];
+            keep(map.isIntersection(t.first, t.second));
+        });
+        bench("Map::getExits", [&] {
+            const auto& t = tiles[i++ & 1023];
+            keep(map.getExits(t.first, t.second, true));
+        });
+        bench("Map::getPathDistance", [&] {
+            const auto& a = tiles[i++ & 1023];
+            const auto& b = tiles[i++ & 1023];
+            keep(map.getPathDistance(a.first, a.second, b.first, b.second));
+        });
+        
+        Map fresh;
+        bench("Map::resetLevel", [&] {
+            fresh.resetLevel();
+            keep(fresh.getRemainingDots());
+        });
+    }
+    
+    // --- Entidades (copias del estado en Playing y de su mapa) ---
+    {
+        Map map = core.getMap();
+        
+        std::vector<Ghost> ghosts = core.getGhosts();
+        GhostLanes ghostLanes;
+        GhostAI::initLanes(ghostLanes, ghosts);
+        size_t g = 0;
+        uint32_t ticks = 0;
+        // Cada 4 ops es un tick: objetivos con la pasada de carriles y un
+        // update por fantasma (incluye Ghost::chooseDirection en los tiles de
+        // decisión). Cada 600 ticks vuelven al estado en Playing.
+        bench("Ghost::update", [&] {
+            size_t i = g++ & 3;
+            if (i == 0) {
+                if (++ticks % 600 == 0) ghosts = core.getGhosts();
+                GhostAI::gatherLanes(ghostLanes, ghosts);
+                GhostAI::computeTargets(ghostLanes, core.getPacman());
+                for (int k = 0; k < ghostLanes.count; k++) {
+                    ghosts[k].setTarget(Vector2i(ghostLanes.targetX[k], ghostLanes.targetY[k]));
+                }
+            }
+            ghosts[i].update(SIM_DT, map);
+        });
+        
+        // Sin avanzar: los 4 fantasmas en el estado de la partida
+        const std::vector<Ghost>& playingGhosts = core.getGhosts();
+        bench("Ghost::chooseDirection", [&] {
+            keep(BenchAccess::chooseDirection(playingGhosts[g++ & 3], map));
+        });
+        
+        PacMan pacman = core.getPacman();
+        int turn = 0;
+        static const Direction turns[] = {Direction::Up, Direction::Left, Direction::Down, Direction::Right};
+        bench("PacMan::update", [&] {
+            if (pacman.direction == Direction::None) {
+                turn = (turn + 1) & 3;
+                pacman.setDesiredDirection(turns[turn]);
+            }
+            pacman.update(SIM_DT, map);
+        });
+        
+        // Reemplaza a GhostAI::getTarget: todos los objetivos en una pasada
+        GhostLanes lanes;
+        GhostAI::initLanes(lanes, core.getGhosts());
+        bench("GhostAI::gatherLanes+computeTargets", [&] {
+            GhostAI::gatherLanes(lanes, core.getGhosts());
+            GhostAI::computeTargets(lanes, core.getPacman());
+            keep(lanes.targetX[0]);
+        });
+    }
+    
+    // --- Núcleo ---
+    {
+        GameCore sim;
+        sim.restore(playing);
+        int turn = 0;
+        uint32_t ticks = 0;
+        // Un tick completo en Playing: movimiento, IA, comer y checkCollisions.
+        // Cada 600 ticks vuelve al mismo estado para que la entrada sea estable.
+        bench("GameCore::update (Playing)", [&] {
+            if (++ticks % 600 == 0) sim.restore(playing);
+            stepHeadless(sim, turn);
+        });
+        
+        GameSnapshot snapshot;
+        bench("GameCore::save", [&] {
+            sim.save(snapshot);
+            keep(snapshot.tick);
+        });
+        bench("GameCore::restore", [&] {
+            sim.restore(playing);
+        });
+        bench("GameCore::getHash", [&] {
+            keep(sim.getHash());
+        });
+        
+        // Pac-Man y los fantasmas del estado en Playing no se tocan: no come
+        // ni muere, así el estado no cambia entre iteraciones
+        GameCore collisions;
+        collisions.restore(playing);
+        bench("GameCore::checkCollisions", [&] {
+            BenchAccess::checkCollisions(collisions);
+            keep(collisions.getScore());
+        });
+    }
+    
+    // --- Render offscreen (renderer por software, sin ventana) ---
+    if (selected("Renderer::drawMaze") || selected("Renderer::drawDots")) {
+        Renderer renderer;
+        if (renderer.initOffscreen()) {
+            TextureManager& tm = TextureManager::get();
+            tm.init(renderer.getSDLRenderer());
+            tm.load("pill", "assets/gfx/pill/pill_0.png");
+            tm.load("super_pill", "assets/gfx/pill/pill_1.png");
+            tm.buildAtlas();
+            renderer.setDotSprites(tm.getSprite("pill"), tm.getSprite("super_pill"));
+            
+            const Map& map = core.getMap();
+            bench("Renderer::drawMaze", [&] {
+                renderer.drawMaze(map);
+            });
+            // Costo de reconstruir el laberinto pre-renderizado (una vez por laberinto)
+            bench("Renderer::drawMaze (rebuild)", [&] {
+                renderer.invalidateCaches();
+                renderer.drawMaze(map);
+            });
+            bench("Renderer::drawDots", [&] {
+                renderer.drawDots(map);
+            });
+            bench("Renderer::drawDots (rebuild)", [&] {
+                renderer.invalidateCaches();
+                renderer.drawDots(map);
+            });
+        }
+        else {
+            std::printf("(render omitido: no se pudo crear el renderer offscreen)\n");
+        }
+    }
+    
+    return 0;
+}
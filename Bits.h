@@ -0,0 +1,40 @@
+// Bits.h
+// Utilidades de bits (bitboards del mapa, buckets de histogramas)
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Cantidad de bits en 1
+inline int popcount32(uint32_t v) {
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt(v));
+#else
+    return __builtin_popcount(v);
+#endif
+}
+
+// Índice del bit menos significativo en 1 (v != 0)
+inline int lowestBit32(uint32_t v) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, v);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(v);
+#endif
+}
+
+// Índice del bit más significativo en 1 (v != 0)
+inline int highestBit64(uint64_t v) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, v);
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(v);
+#endif
+}
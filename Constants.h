@@ -18,17 +18,30 @@ constexpr int SCREEN_HEIGHT = (MAP_HEIGHT * TILE_SIZE + 16) * SCALE; // HUD arri
 // Offset para el área de juego (HUD arriba)
 constexpr int GAME_OFFSET_Y = 24 * SCALE;  // Espacio para score arriba
 
-// Velocidades (píxeles por segundo, escaladas)
-// El Pac-Man original corre a ~80% de velocidad base
-constexpr float BASE_SPEED = 75.75f * SCALE;  // Velocidad base
-constexpr float PACMAN_SPEED = BASE_SPEED * 0.80f;
-constexpr float PACMAN_FRIGHT_SPEED = BASE_SPEED * 0.90f;
-constexpr float PACMAN_DOT_SPEED = BASE_SPEED * 0.71f;
-
-constexpr float GHOST_SPEED = BASE_SPEED * 0.75f;
-constexpr float GHOST_FRIGHT_SPEED = BASE_SPEED * 0.50f;
-constexpr float GHOST_TUNNEL_SPEED = BASE_SPEED * 0.40f;
-constexpr float GHOST_EYES_SPEED = BASE_SPEED * 1.50f;
+// Simulación a paso fijo (independiente de la tasa de refresco)
+constexpr int SIM_TICK_RATE = 60;                 // Ticks por segundo
+constexpr float SIM_DT = 1.0f / SIM_TICK_RATE;    // Duración de un tick
+constexpr int MAX_SIM_STEPS_PER_FRAME = 5;        // Máximo de ticks de recuperación por frame
+
+// Punto fijo: posiciones en sub-píxeles enteros (1/256 de píxel escalado).
+// Toda la simulación de movimiento es aritmética entera: idéntica en cualquier CPU.
+constexpr int FIXED_SHIFT = 8;
+constexpr int FIXED_ONE = 1 << FIXED_SHIFT;          // 1 píxel escalado
+constexpr int FIXED_TILE = SCALED_TILE * FIXED_ONE;  // 1 tile
+
+constexpr int tileToFixed(int tile) { return tile * FIXED_TILE; }
+
+// Velocidades (sub-píxeles por tick, escaladas)
+// El Pac-Man original corre a ~80% de velocidad base (75.75 px/s)
+constexpr int BASE_SPEED = 7575 * SCALE * FIXED_ONE / (100 * SIM_TICK_RATE);
+constexpr int PACMAN_SPEED = BASE_SPEED * 80 / 100;
+constexpr int PACMAN_FRIGHT_SPEED = BASE_SPEED * 90 / 100;
+constexpr int PACMAN_DOT_SPEED = BASE_SPEED * 71 / 100;
+
+constexpr int GHOST_SPEED = BASE_SPEED * 75 / 100;
+constexpr int GHOST_FRIGHT_SPEED = BASE_SPEED * 50 / 100;
+constexpr int GHOST_TUNNEL_SPEED = BASE_SPEED * 40 / 100;
+constexpr int GHOST_EYES_SPEED = BASE_SPEED * 150 / 100;
 
 // Puntuaciones (arcade original)
 constexpr int SCORE_DOT = 10;
@@ -56,6 +69,10 @@ constexpr int PACMAN_START_Y = 22;  // Corredor horizontal con pellets
 constexpr int GHOST_HOUSE_X = 13;
 constexpr int GHOST_HOUSE_Y = 14;
 
+// Tile de la fruta (debajo de la casa de los fantasmas)
+constexpr int FRUIT_TILE_X = 13;
+constexpr int FRUIT_TILE_Y = 17;
+
 // Scatter corners (esquinas de dispersión)
 constexpr int BLINKY_SCATTER_X = 25;
 constexpr int BLINKY_SCATTER_Y = 0;
@@ -1,6 +1,8 @@
 // Direction.h
 #pragma once
 
+#include <cstdint>
+
 enum class Direction {
     None,
     Up,
@@ -19,3 +21,9 @@ inline Direction oppositeDirection(Direction d) {
         default: return Direction::None;
     }
 }
+
+// Bit de la dirección en las máscaras de salida del mapa (None = 0)
+inline uint8_t directionBit(Direction d) {
+    static constexpr uint8_t bits[] = {0, 1, 2, 4, 8};
+    return bits[static_cast<int>(d)];
+}
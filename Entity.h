@@ -5,45 +5,94 @@
 #include "Math.h"
 #include "Direction.h"
 #include "Constants.h"
-#include <cmath>
 
+class Map;
+
+// Base CRTP: Derived implementa onUpdate(dt, map) y onReset().
+// Sin métodos virtuales, las llamadas se resuelven en compilación (se pueden
+// inlinear) y las entidades no llevan puntero a vtable.
+template <typename Derived>
 class Entity {
 public:
-    virtual ~Entity() = default;
-    
-    virtual void update(float dt) = 0;
-    virtual void reset() = 0;
-
-    // Posición en píxeles (escalados)
-    Vector2 position;
+    // El mapa es de la partida (no hay singleton): se pasa en cada update.
+    // dt solo avanza los timers; el movimiento es un paso fijo por tick (SIM_DT).
+    void update(float dt, Map& map) { static_cast<Derived*>(this)->onUpdate(dt, map); }
+    void reset() { static_cast<Derived*>(this)->onReset(); }
     
     // Dirección actual de movimiento
     Direction direction = Direction::None;
     
-    // Velocidad actual
-    float speed = 0.0f;
+    // Velocidad actual (sub-píxeles por tick)
+    int speed = 0;
     
-    // Obtener tile actual
-    int getTileX() const {
-        return static_cast<int>((position.x / SCALE + TILE_SIZE / 2) / TILE_SIZE);
-    }
+    // Posición en punto fijo (ver FIXED_SHIFT)
+    const Vector2i& getPosition() const { return position; }
     
-    int getTileY() const {
-        return static_cast<int>((position.y / SCALE + TILE_SIZE / 2) / TILE_SIZE);
+    // Posición en píxeles escalados (render y efectos)
+    Vector2 getPixelPosition() const {
+        return Vector2(static_cast<float>(position.x) / FIXED_ONE,
+                       static_cast<float>(position.y) / FIXED_ONE);
     }
     
+    // Tile actual (cacheado, se recalcula solo al moverse)
+    int getTileX() const { return tileX; }
+    int getTileY() const { return tileY; }
+    
     // Verificar si está centrado en un tile (con tolerancia)
     bool isCentered() const {
-        float tileSize = static_cast<float>(TILE_SIZE * SCALE);
-        float offsetX = std::fmod(position.x, tileSize);
-        float offsetY = std::fmod(position.y, tileSize);
+        int offsetX = position.x % FIXED_TILE;
+        int offsetY = position.y % FIXED_TILE;
         
         // Tolerancia de 3 píxeles escalados
-        float tolerance = 3.0f;
+        constexpr int tolerance = 3 * FIXED_ONE;
         
-        bool centeredX = (offsetX <= tolerance) || (offsetX >= tileSize - tolerance);
-        bool centeredY = (offsetY <= tolerance) || (offsetY >= tileSize - tolerance);
+        bool centeredX = (offsetX <= tolerance) || (offsetX >= FIXED_TILE - tolerance);
+        bool centeredY = (offsetY <= tolerance) || (offsetY >= FIXED_TILE - tolerance);
         
         return centeredX && centeredY;
     }
+
+protected:
+    Entity() = default;
+    ~Entity() = default;
+    
+    // Wrap horizontal en los túneles (un tile fuera de cada borde)
+    void handleTunnelWrap() {
+        if (position.x < -FIXED_TILE) {
+            setPositionX(tileToFixed(MAP_WIDTH));
+        }
+        else if (position.x > tileToFixed(MAP_WIDTH)) {
+            setPositionX(-FIXED_TILE);
+        }
+    }
+    
+    void setPosition(int x, int y) {
+        position.x = x;
+        position.y = y;
+        updateTileX();
+        updateTileY();
+    }
+    
+    void setPositionX(int x) { position.x = x; updateTileX(); }
+    void setPositionY(int y) { position.y = y; updateTileY(); }
+    
+    // Avanza en la dirección dada; el tile solo se recalcula en el eje que cambia
+    void moveBy(Direction dir, int amount) {
+        switch (dir) {
+            case Direction::Up:    setPositionY(position.y - amount); break;
+            case Direction::Down:  setPositionY(position.y + amount); break;
+            case Direction::Left:  setPositionX(position.x - amount); break;
+            case Direction::Right: setPositionX(position.x + amount); break;
+            default: break;
+        }
+    }
+
+private:
+    Vector2i position;
+    int tileX = 0;
+    int tileY = 0;
+    
+    // El tile es el que contiene el centro del sprite (truncado hacia cero, como antes)
+    void updateTileX() { tileX = (position.x + FIXED_TILE / 2) / FIXED_TILE; }
+    void updateTileY() { tileY = (position.y + FIXED_TILE / 2) / FIXED_TILE; }
 };
@@ -0,0 +1,130 @@
+// FrameStats.cpp
+#include "FrameStats.h"
+#include "Bits.h"
+#include <cstdio>
+
+int LatencyHistogram::bucketIndex(uint64_t ns) {
+    if (ns < LINEAR_COUNT)
+        return static_cast<int>(ns);
+    
+    int exponent = highestBit64(ns);
+    int sub = static_cast<int>(ns >> (exponent - SUB_BITS)) & (SUB_COUNT - 1);
+    return LINEAR_COUNT + (exponent - SUB_BITS - 1) * SUB_COUNT + sub;
+}
+
+uint64_t LatencyHistogram::bucketLower(int index) {
+    if (index < LINEAR_COUNT)
+        return static_cast<uint64_t>(index);
+    
+    int exponent = (index - LINEAR_COUNT) / SUB_COUNT + SUB_BITS + 1;
+    uint64_t sub = static_cast<uint64_t>((index - LINEAR_COUNT) % SUB_COUNT);
+    return (SUB_COUNT + sub) << (exponent - SUB_BITS);
+}
+
+uint64_t LatencyHistogram::bucketUpper(int index) {
+    if (index < LINEAR_COUNT)
+        return static_cast<uint64_t>(index) + 1;
+    
+    int exponent = (index - LINEAR_COUNT) / SUB_COUNT + SUB_BITS + 1;
+    return bucketLower(index) + (uint64_t(1) << (exponent - SUB_BITS));
+}
+
+uint64_t LatencyHistogram::percentile(double q) const {
+    uint64_t total = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) total += getBucket(i);
+    if (total == 0)
+        return 0;
+    
+    // Rango 1..total del valor buscado
+    uint64_t rank = static_cast<uint64_t>(q * total + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > total) rank = total;
+    
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += getBucket(i);
+        if (seen >= rank) {
+            uint64_t mid = bucketLower(i) + (bucketUpper(i) - bucketLower(i)) / 2;
+            return mid < getMax() ? mid : getMax();
+        }
+    }
+    return getMax();
+}
+
+// ===== EXPORT =====
+
+// Límites "le" publicados: potencias de 2 de 2^10 ns (~1 µs) a 2^32 ns (~4.3 s).
+// Coinciden con bordes de bucket, así los acumulados son exactos.
+static constexpr int EXPORT_MIN_EXPONENT = 10;
+static constexpr int EXPORT_MAX_EXPONENT = 32;
+
+static void appendHistogram(std::string& out, const char* name, const char* help,
+                            const LatencyHistogram& h) {
+    char line[256];
+    std::snprintf(line, sizeof(line), "# HELP %s %s\n# TYPE %s histogram\n", name, help, name);
+    out += line;
+    
+    // El +Inf y _count salen de los mismos buckets (coherentes aunque se lea
+    // mientras el hilo principal escribe)
+    uint64_t cumulative = 0;
+    int bucket = 0;
+    for (int e = EXPORT_MIN_EXPONENT; e <= EXPORT_MAX_EXPONENT; e++) {
+        uint64_t bound = uint64_t(1) << e;
+        for (; bucket < LatencyHistogram::BUCKET_COUNT && LatencyHistogram::bucketUpper(bucket) <= bound; bucket++) {
+            cumulative += h.getBucket(bucket);
+        }
+        std::snprintf(line, sizeof(line), "%s_bucket{le=\"%.9g\"} %llu\n",
+                      name, bound / 1e9, static_cast<unsigned long long>(cumulative));
+        out += line;
+    }
+    for (; bucket < LatencyHistogram::BUCKET_COUNT; bucket++) {
+        cumulative += h.getBucket(bucket);
+    }
+    
+    std::snprintf(line, sizeof(line), "%s_bucket{le=\"+Inf\"} %llu\n%s_sum %.9f\n%s_count %llu\n",
+                  name, static_cast<unsigned long long>(cumulative),
+                  name, h.getSum() / 1e9,
+                  name, static_cast<unsigned long long>(cumulative));
+    out += line;
+}
+
+static void appendCounter(std::string& out, const char* name, const char* help, uint64_t value) {
+    char line[256];
+    std::snprintf(line, sizeof(line), "# HELP %s %s\n# TYPE %s counter\n%s %llu\n",
+                  name, help, name, name, static_cast<unsigned long long>(value));
+    out += line;
+}
+
+static void appendGauge(std::string& out, const char* name, const char* help, double value) {
+    char line[256];
+    std::snprintf(line, sizeof(line), "# HELP %s %s\n# TYPE %s gauge\n%s %.9f\n",
+                  name, help, name, name, value);
+    out += line;
+}
+
+void FrameStats::writePrometheus(std::string& out) const {
+    appendHistogram(out, "pacman_frame_seconds", "Time between frames (includes vsync).", frame);
+    appendHistogram(out, "pacman_sim_seconds", "Simulation time per frame.", sim);
+    appendHistogram(out, "pacman_render_seconds", "Render and present time per frame.", render);
+    appendGauge(out, "pacman_frame_max_seconds", "Longest frame since start.", frame.getMax() / 1e9);
+    appendCounter(out, "pacman_sim_ticks_total", "Simulation ticks run.", simTicks.load(std::memory_order_relaxed));
+    appendCounter(out, "pacman_dropped_catchup_total", "Frames that dropped simulation time to catch up.",
+                  droppedCatchUps.load(std::memory_order_relaxed));
+}
+
+static void printLine(std::ostream& out, const char* name, const LatencyHistogram& h) {
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-7s p50 %8.3f  p99 %8.3f  p99.9 %8.3f  max %8.3f ms\n",
+                  name, h.percentile(0.5) / 1e6, h.percentile(0.99) / 1e6,
+                  h.percentile(0.999) / 1e6, h.getMax() / 1e6);
+    out << line;
+}
+
+void FrameStats::printReport(std::ostream& out) const {
+    out << "frames: " << frame.getCount()
+        << "  sim ticks: " << simTicks.load(std::memory_order_relaxed)
+        << "  dropped catch-ups: " << droppedCatchUps.load(std::memory_order_relaxed) << "\n";
+    printLine(out, "frame", frame);
+    printLine(out, "sim", sim);
+    printLine(out, "render", render);
+}
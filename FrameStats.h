@@ -0,0 +1,72 @@
+// FrameStats.h
+// Histogramas de latencia por frame (frame, simulación y render) siempre activos
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// Histograma logarítmico en nanosegundos: 8 sub-buckets por potencia de 2
+// (error relativo <= 12.5%), sin asignar memoria. Un solo hilo escribe y
+// cualquier otro puede leer (contadores atómicos relajados).
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BITS = 3;
+    static constexpr int SUB_COUNT = 1 << SUB_BITS;
+    static constexpr int LINEAR_COUNT = 2 * SUB_COUNT;  // 0..15 ns exactos
+    static constexpr int BUCKET_COUNT = LINEAR_COUNT + (64 - SUB_BITS - 1) * SUB_COUNT;
+    
+    void record(uint64_t ns) {
+        increment(buckets[bucketIndex(ns)], 1);
+        increment(count, 1);
+        increment(sum, ns);
+        if (ns > max.load(std::memory_order_relaxed)) max.store(ns, std::memory_order_relaxed);
+    }
+    
+    uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+    uint64_t getSum() const { return sum.load(std::memory_order_relaxed); }
+    uint64_t getMax() const { return max.load(std::memory_order_relaxed); }
+    uint64_t getBucket(int index) const { return buckets[index].load(std::memory_order_relaxed); }
+    
+    // Valor en el percentil q (0..1): punto medio de su bucket, sin pasar el máximo
+    uint64_t percentile(double q) const;
+    
+    static int bucketIndex(uint64_t ns);
+    static uint64_t bucketLower(int index);
+    static uint64_t bucketUpper(int index);  // Exclusivo
+
+private:
+    std::atomic<uint64_t> buckets[BUCKET_COUNT] = {};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> max{0};
+    
+    // Un solo escritor: load + store en vez de fetch_add (sin lock en el bus)
+    static void increment(std::atomic<uint64_t>& counter, uint64_t value) {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+};
+
+// Tiempos del game loop. frame = entre dos frames (incluye VSync),
+// sim = ticks de GameCore del frame, render = Game::render (incluye present).
+struct FrameStats {
+    LatencyHistogram frame;
+    LatencyHistogram sim;
+    LatencyHistogram render;
+    std::atomic<uint64_t> simTicks{0};
+    std::atomic<uint64_t> droppedCatchUps{0};  // Frames que descartaron tiempo atrasado
+    
+    void addSimTicks(int steps) {
+        simTicks.store(simTicks.load(std::memory_order_relaxed) + steps, std::memory_order_relaxed);
+    }
+    void addDroppedCatchUp() {
+        droppedCatchUps.store(droppedCatchUps.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+    
+    // Formato de texto de Prometheus (histogramas en segundos)
+    void writePrometheus(std::string& out) const;
+    
+    // p50/p99/p99.9/max en ms (al salir)
+    void printReport(std::ostream& out) const;
+};
@@ -1,9 +1,8 @@
 // Game.cpp - Pac-Man Versión 3.0
 #include "Game.h"
-#include "GhostAI.h"
-#include "Map.h"
 #include "TextureManager.h"
 #include "Constants.h"
+#include "Profiler.h"
 #include <SDL2/SDL.h>
 #include <cmath>
 #include <iostream>
@@ -16,18 +15,34 @@
 #include <direct.h>
 #endif
 
-// Tiempos de Scatter/Chase
-static const float SCATTER_TIMES[] = {7.0f, 7.0f, 5.0f, 5.0f};
-static const float CHASE_TIMES[] = {20.0f, 20.0f, 20.0f, 999999.0f};
-
-Game::Game() {}
+Game::Game() {
+    recording.begin(core.getSeed(), core.getLevel());
+}
 
 Game::~Game() {
+    if (!recordPath.empty()) {
+        recording.finish(core.getTick());
+        if (!recording.save(recordPath)) {
+            std::cerr << "Could not save replay: " << recordPath << std::endl;
+        }
+    }
+    if (profileOnExit) {
+        dumpProfile();
+    }
+    // Misma línea que el modo headless (Main.cpp)
+    if (autopilot) {
+        std::cout << "autopilot: " << autopilot->getThreadCount() << " threads"
+                  << "  rollouts: " << autopilot->getRollouts()
+                  << "  rollouts/s: " << static_cast<long>(autopilot->getRolloutsPerSecond()) << std::endl;
+    }
     saveHighScore();
     AudioManager::get().shutdown();
 }
 
 bool Game::init() {
+    // El hilo principal graba sus zonas (ver Profiler.h)
+    Profiler::registerThread("main");
+    
     if (!renderer.init()) {
         std::cerr << "Failed to initialize renderer" << std::endl;
         return false;
@@ -38,18 +53,10 @@ bool Game::init() {
     AudioManager::get().init();
     
     loadHighScore();
-    previousHighScore = highScore;
-    
-    ghosts.push_back(Ghost(GhostType::Blinky));
-    ghosts.push_back(Ghost(GhostType::Pinky));
-    ghosts.push_back(Ghost(GhostType::Inky));
-    ghosts.push_back(Ghost(GhostType::Clyde));
     
     // Inicializar área del icono de volumen
     volumeIconRect = {0, 0, 0, 0};
     
-    state = GameState::PressStart;
-    
     return true;
 }
 
@@ -66,16 +73,17 @@ std::string Game::getHighScorePath() const {
 }
 
 void Game::loadHighScore() {
+    int highScore = 0;
     std::ifstream file(getHighScorePath(), std::ios::binary);
     if (file.is_open()) {
         file.read(reinterpret_cast<char*>(&highScore), sizeof(highScore));
         file.close();
-    } else {
-        highScore = 0;
     }
+    core.setHighScore(highScore);
 }
 
 void Game::saveHighScore() {
+    int highScore = core.getHighScore();
     std::ofstream file(getHighScorePath(), std::ios::binary);
     if (file.is_open()) {
         file.write(reinterpret_cast<const char*>(&highScore), sizeof(highScore));
@@ -84,27 +92,50 @@ void Game::saveHighScore() {
 }
 
 void Game::resetHighScore() {
-    highScore = 0;
-    previousHighScore = 0;
-    highScoreBeaten = false;
+    core.resetHighScore();
     saveHighScore();
     
     highScoreResetBlinkTimer = 1.5f;
     AudioManager::get().playSound(SoundID::Success);
 }
 
+// Orden de las tablas de sprites de fantasmas (índice 0-3)
+static const char* GHOST_DIRECTIONS[] = {"up", "down", "left", "right"};
+
+// Índice de GHOST_DIRECTIONS (None: izquierda, como los ojos de siempre)
+static int ghostSpriteDirection(Direction d) {
+    switch (d) {
+        case Direction::Up:    return 0;
+        case Direction::Down:  return 1;
+        case Direction::Right: return 3;
+        default:               return 2;
+    }
+}
+
+// En el orden de FruitType
+static const char* FRUIT_NAMES[] = {
+    "cherry", "strawberry", "orange", "apple", "melon", "ship", "bell", "key"
+};
+static const char* FRUIT_POINTS_FILES[] = {
+    "first_fruit", "second_fruit", "third_fruit", "fourth_fruit",
+    "fifth_fruit", "sixth_fruit", "seventh_fruit", "eight_fruit"
+};
+
 void Game::loadAllTextures() {
     auto& tm = TextureManager::get();
     
-    // Pac-Man (movimiento)
+    // Pac-Man (movimiento), con copias giradas para las 4 direcciones
     tm.load("pacman_0", "assets/gfx/pacman/pac_man_0.png");
     tm.load("pacman_1", "assets/gfx/pacman/pac_man_1.png");
     tm.load("pacman_2", "assets/gfx/pacman/pac_man_2.png");
     tm.load("pacman_3", "assets/gfx/pacman/pac_man_3.png");
     tm.load("pacman_4", "assets/gfx/pacman/pac_man_4.png");
+    for (int i = 0; i < PACMAN_ANIM_FRAMES; i++) {
+        tm.addRotations("pacman_" + std::to_string(i));
+    }
     
     // Pac-Man (muerte - 12 frames)
-    for (int i = 0; i < 12; i++) {
+    for (int i = 0; i < PACMAN_DEATH_FRAMES; i++) {
         std::string key = "pacman_death_" + std::to_string(i);
         std::string path = "assets/gfx/pacman_death/pacdeath_" + std::to_string(i) + ".png";
         tm.load(key, path);
@@ -114,12 +145,10 @@ void Game::loadAllTextures() {
     tm.load("pacman_life", "assets/gfx/pacman_counter/lifecounter_0.png");
     
     // Fantasmas con direcciones (4 fantasmas x 4 direcciones x 2 frames = 32 sprites)
-    const char* colors[] = {"red", "pink", "blue", "orange"};
-    const char* dirs[] = {"up", "down", "left", "right"};
-    
-    for (const char* color : colors) {
-        for (const char* dir : dirs) {
-            for (int frame = 0; frame < 2; frame++) {
+    for (int type = 0; type < GhostPersonalities::count; type++) {
+        const char* color = ghostTraits(static_cast<GhostType>(type)).color;
+        for (const char* dir : GHOST_DIRECTIONS) {
+            for (int frame = 0; frame < GHOST_ANIM_FRAMES; frame++) {
                 std::string key = std::string("ghost_") + color + "_" + dir + "_" + std::to_string(frame);
                 std::string path = std::string("assets/gfx/ghost/") + color + "_ghost/ghost_" + color + "_" + dir + "_" + std::to_string(frame) + ".png";
                 tm.load(key, path);
@@ -128,46 +157,33 @@ void Game::loadAllTextures() {
     }
     
     // Fantasmas asustados (4 frames: 0-1 azul, 2-3 blanco para parpadeo)
-    tm.load("ghost_afraid_0", "assets/gfx/ghost/ghost_afraid/afraid_0.png");
-    tm.load("ghost_afraid_1", "assets/gfx/ghost/ghost_afraid/afraid_1.png");
-    tm.load("ghost_afraid_2", "assets/gfx/ghost/ghost_afraid/afraid_2.png");
-    tm.load("ghost_afraid_3", "assets/gfx/ghost/ghost_afraid/afraid_3.png");
+    for (int i = 0; i < FRIGHTENED_FRAMES; i++) {
+        tm.load("ghost_afraid_" + std::to_string(i),
+                "assets/gfx/ghost/ghost_afraid/afraid_" + std::to_string(i) + ".png");
+    }
     
     // Ojos de fantasmas
-    tm.load("ghost_eyes_up", "assets/gfx/ghost/eyes/eyes_up.png");
-    tm.load("ghost_eyes_down", "assets/gfx/ghost/eyes/eyes_down.png");
-    tm.load("ghost_eyes_left", "assets/gfx/ghost/eyes/eyes_left.png");
-    tm.load("ghost_eyes_right", "assets/gfx/ghost/eyes/eyes_right.png");
+    for (const char* dir : GHOST_DIRECTIONS) {
+        tm.load(std::string("ghost_eyes_") + dir, std::string("assets/gfx/ghost/eyes/eyes_") + dir + ".png");
+    }
     
     // Pills
     tm.load("pill", "assets/gfx/pill/pill_0.png");
     tm.load("super_pill", "assets/gfx/pill/pill_1.png");
     
-    // Frutas (8 tipos)
-    tm.load("fruit_cherry", "assets/gfx/fruits/spr_cherry_0.png");
-    tm.load("fruit_strawberry", "assets/gfx/fruits/spr_strawberry_0.png");
-    tm.load("fruit_orange", "assets/gfx/fruits/spr_orange_0.png");
-    tm.load("fruit_apple", "assets/gfx/fruits/spr_apple_0.png");
-    tm.load("fruit_melon", "assets/gfx/fruits/spr_melon_0.png");
-    tm.load("fruit_ship", "assets/gfx/fruits/spr_ship_0.png");
-    tm.load("fruit_bell", "assets/gfx/fruits/spr_bell_0.png");
-    tm.load("fruit_key", "assets/gfx/fruits/spr_key_0.png");
-    
-    // Sprites de puntaje de frutas
-    tm.load("points_fruit_100", "assets/gfx/points/fruits/first_fruit.png");
-    tm.load("points_fruit_300", "assets/gfx/points/fruits/second_fruit.png");
-    tm.load("points_fruit_500", "assets/gfx/points/fruits/third_fruit.png");
-    tm.load("points_fruit_700", "assets/gfx/points/fruits/fourth_fruit.png");
-    tm.load("points_fruit_1000", "assets/gfx/points/fruits/fifth_fruit.png");
-    tm.load("points_fruit_2000", "assets/gfx/points/fruits/sixth_fruit.png");
-    tm.load("points_fruit_3000", "assets/gfx/points/fruits/seventh_fruit.png");
-    tm.load("points_fruit_5000", "assets/gfx/points/fruits/eight_fruit.png");
-    
-    // Sprites de puntaje de fantasmas
-    tm.load("points_ghost_200", "assets/gfx/points/ghosts/first_ghost.png");
-    tm.load("points_ghost_400", "assets/gfx/points/ghosts/second_ghost.png");
-    tm.load("points_ghost_800", "assets/gfx/points/ghosts/third_ghost.png");
-    tm.load("points_ghost_1600", "assets/gfx/points/ghosts/fourth_ghost.png");
+    // Frutas (8 tipos) y sus sprites de puntaje, en el orden de FruitType
+    for (int i = 0; i < FRUIT_TYPES; i++) {
+        tm.load(std::string("fruit_") + FRUIT_NAMES[i],
+                std::string("assets/gfx/fruits/spr_") + FRUIT_NAMES[i] + "_0.png");
+        tm.load(std::string("points_fruit_") + FRUIT_NAMES[i],
+                std::string("assets/gfx/points/fruits/") + FRUIT_POINTS_FILES[i] + ".png");
+    }
+    
+    // Sprites de puntaje de fantasmas (200, 400, 800, 1600)
+    tm.load("points_ghost_0", "assets/gfx/points/ghosts/first_ghost.png");
+    tm.load("points_ghost_1", "assets/gfx/points/ghosts/second_ghost.png");
+    tm.load("points_ghost_2", "assets/gfx/points/ghosts/third_ghost.png");
+    tm.load("points_ghost_3", "assets/gfx/points/ghosts/fourth_ghost.png");
     
     // Textos
     tm.load("text_ready", "assets/gfx/pacman_text/ready.png");
@@ -181,124 +197,108 @@ void Game::loadAllTextures() {
     tm.load("volume_50", "assets/gfx/volume/sound_50.png");
     tm.load("volume_25", "assets/gfx/volume/sound_25.png");
     tm.load("volume_0", "assets/gfx/volume/no_sound.png");
-}
-
-FruitInfo Game::getCurrentFruitInfo() const {
-    FruitInfo info;
-    
-    switch (level) {
-        case 1:
-            info.type = FruitType::Cherry;
-            info.textureKey = "fruit_cherry";
-            info.pointsTextureKey = "points_fruit_100";
-            info.points = 100;
-            break;
-        case 2:
-            info.type = FruitType::Strawberry;
-            info.textureKey = "fruit_strawberry";
-            info.pointsTextureKey = "points_fruit_300";
-            info.points = 300;
-            break;
-        case 3:
-        case 4:
-            info.type = FruitType::Orange;
-            info.textureKey = "fruit_orange";
-            info.pointsTextureKey = "points_fruit_500";
-            info.points = 500;
-            break;
-        case 5:
-        case 6:
-            info.type = FruitType::Apple;
-            info.textureKey = "fruit_apple";
-            info.pointsTextureKey = "points_fruit_700";
-            info.points = 700;
-            break;
-        case 7:
-        case 8:
-            info.type = FruitType::Melon;
-            info.textureKey = "fruit_melon";
-            info.pointsTextureKey = "points_fruit_1000";
-            info.points = 1000;
-            break;
-        case 9:
-        case 10:
-            info.type = FruitType::Ship;
-            info.textureKey = "fruit_ship";
-            info.pointsTextureKey = "points_fruit_2000";
-            info.points = 2000;
-            break;
-        case 11:
-        case 12:
-            info.type = FruitType::Bell;
-            info.textureKey = "fruit_bell";
-            info.pointsTextureKey = "points_fruit_3000";
-            info.points = 3000;
-            break;
-        default:  // Nivel 13+
-            info.type = FruitType::Key;
-            info.textureKey = "fruit_key";
-            info.pointsTextureKey = "points_fruit_5000";
-            info.points = 5000;
-            break;
+    
+    // Todo en una textura: los sprites de un frame van en un solo lote
+    tm.buildAtlas();
+    
+    // Tablas de sprites (los punteros no cambian hasta TextureManager::clear)
+    static const char* rotations[] = {"", "_90", "_180", "_270"};
+    for (int i = 0; i < PACMAN_ANIM_FRAMES; i++) {
+        for (int turns = 0; turns < 4; turns++) {
+            pacmanSprites[i][turns] = tm.getSprite("pacman_" + std::to_string(i) + rotations[turns]);
+        }
     }
+    for (int i = 0; i < PACMAN_DEATH_FRAMES; i++) {
+        pacmanDeathSprites[i] = tm.getSprite("pacman_death_" + std::to_string(i));
+    }
+    lifeSprite = tm.getSprite("pacman_life");
     
-    return info;
-}
-
-std::string Game::getGhostPointsTexture(int ghostIndex) const {
-    switch (ghostIndex) {
-        case 0: return "points_ghost_200";
-        case 1: return "points_ghost_400";
-        case 2: return "points_ghost_800";
-        default: return "points_ghost_1600";
+    for (int type = 0; type < GhostPersonalities::count; type++) {
+        const char* color = ghostTraits(static_cast<GhostType>(type)).color;
+        for (int dir = 0; dir < 4; dir++) {
+            for (int frame = 0; frame < GHOST_ANIM_FRAMES; frame++) {
+                ghostSprites[type][dir][frame] = tm.getSprite(std::string("ghost_") + color + "_" +
+                                                              GHOST_DIRECTIONS[dir] + "_" + std::to_string(frame));
+            }
+        }
     }
-}
-
-std::string Game::getFruitTextureForLevel(int lvl) const {
-    if (lvl == 1) return "fruit_cherry";
-    if (lvl == 2) return "fruit_strawberry";
-    if (lvl <= 4) return "fruit_orange";
-    if (lvl <= 6) return "fruit_apple";
-    if (lvl <= 8) return "fruit_melon";
-    if (lvl <= 10) return "fruit_ship";
-    if (lvl <= 12) return "fruit_bell";
-    return "fruit_key";
-}
-
-float Game::getSpeedMultiplier() const {
-    float multiplier = 1.0f + (std::min(level - 1, 6) * 0.05f);
-    return multiplier;
+    for (int i = 0; i < FRIGHTENED_FRAMES; i++) {
+        frightenedSprites[i] = tm.getSprite("ghost_afraid_" + std::to_string(i));
+    }
+    for (int dir = 0; dir < 4; dir++) {
+        eyesSprites[dir] = tm.getSprite(std::string("ghost_eyes_") + GHOST_DIRECTIONS[dir]);
+    }
+    
+    for (int i = 0; i < FRUIT_TYPES; i++) {
+        fruitSprites[i] = tm.getSprite(std::string("fruit_") + FRUIT_NAMES[i]);
+        fruitPointsSprites[i] = tm.getSprite(std::string("points_fruit_") + FRUIT_NAMES[i]);
+    }
+    for (int i = 0; i < GHOST_COMBO_SPRITES; i++) {
+        ghostPointsSprites[i] = tm.getSprite("points_ghost_" + std::to_string(i));
+    }
+    
+    readySprite = tm.getSprite("text_ready");
+    gameOverSprite = tm.getSprite("text_gameover");
+    clearSprite = tm.getSprite("text_clear");
+    pressStartSprite = tm.getSprite("text_pressstart");
+    pauseSprite = tm.getSprite("text_pause");
+    
+    volumeSprites[0] = tm.getSprite("volume_100");
+    volumeSprites[1] = tm.getSprite("volume_50");
+    volumeSprites[2] = tm.getSprite("volume_25");
+    volumeSprites[3] = tm.getSprite("volume_0");
+    
+    renderer.setDotSprites(tm.getSprite("pill"), tm.getSprite("super_pill"));
 }
 
 void Game::handleInput() {
+    PROFILE_ZONE("Game::handleInput");
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
         if (event.type == SDL_QUIT) {
             running = false;
         }
+        else if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) {
+            // Se perdió el contenido de las texturas render target
+            renderer.invalidateCaches();
+        }
         else if (event.type == SDL_KEYDOWN) {
+            GameState state = core.getState();
+            
+            // Durante un replay solo se puede salir
+            if (playback) {
+                if (event.key.keysym.sym == SDLK_ESCAPE) running = false;
+                if (event.key.keysym.sym == SDLK_F12) dumpProfile();
+                continue;
+            }
+            
             switch (event.key.keysym.sym) {
                 case SDLK_UP:
                 case SDLK_w:
-                    if (state == GameState::Playing)
-                        pacman.setDesiredDirection(Direction::Up);
+                    performAction(PlayerAction::Up);
                     break;
                 case SDLK_DOWN:
                 case SDLK_s:
-                    if (state == GameState::Playing)
-                        pacman.setDesiredDirection(Direction::Down);
+                    performAction(PlayerAction::Down);
                     break;
                 case SDLK_LEFT:
                 case SDLK_a:
-                    if (state == GameState::Playing)
-                        pacman.setDesiredDirection(Direction::Left);
+                    performAction(PlayerAction::Left);
                     break;
                 case SDLK_RIGHT:
                 case SDLK_d:
-                    if (state == GameState::Playing)
-                        pacman.setDesiredDirection(Direction::Right);
+                    performAction(PlayerAction::Right);
+                    break;
+                
+                case SDLK_F12:
+                    dumpProfile();
+                    break;
+                
+                case SDLK_TAB:
+                    if (!autopilot) autopilot.reset(new Autopilot(autopilotConfig));
+                    autopilotEnabled = !autopilotEnabled;
                     break;
-                    
+                
                 case SDLK_r:
                     if (state == GameState::PressStart || 
                         state == GameState::GameOver ||
@@ -306,51 +306,20 @@ void Game::handleInput() {
                         resetHighScore();
                     }
                     break;
-                    
+                
                 case SDLK_RETURN:
                     if (state == GameState::PressStart) {
-                        state = GameState::Startup;
-                        stateTimer = 0.0f;
-                        AudioManager::get().playSound(SoundID::Startup);
+                        performAction(PlayerAction::Start);
                     }
                     else if (state == GameState::GameOver) {
-                        previousHighScore = highScore;
-                        highScoreBeaten = false;
-                        highScoreBlinkTimer = 0.0f;
-                        highScoreBlinkAccum = 0.0f;
-                        highScoreBlinkState = false;
-                        score = 0;
-                        lives = 3;
-                        level = 1;
-                        collectedFruits.clear();
-                        Map::get().resetLevel();
-                        startLevel();
+                        performAction(PlayerAction::NewGame);
                     }
                     break;
-                    
+                
                 case SDLK_ESCAPE:
-                    if (state == GameState::Playing) {
-                        stateBeforePause = state;
-                        state = GameState::Paused;
-                        // Detener todos los sonidos de juego
-                        AudioManager::get().stopSiren();
-                        AudioManager::get().stopSound(SoundID::Waka);
-                        AudioManager::get().stopSound(SoundID::PowerUp);
-                        AudioManager::get().stopSound(SoundID::BackToBase);
-                        wakaPlaying = false;
-                        AudioManager::get().playSound(SoundID::Pause);
-                    }
-                    else if (state == GameState::Paused) {
-                        state = stateBeforePause;
-                        AudioManager::get().playSound(SoundID::Unpause);
-                        // Reanudar sonido apropiado según estado
-                        if (frightenedTimer > 0.0f) {
-                            AudioManager::get().playSound(SoundID::PowerUp, -1);
-                        } else {
-                            AudioManager::get().playSiren(sirenFast);
-                        }
-                    }
-                    else if (state == GameState::PressStart) {
+                    if (!performAction(PlayerAction::Pause) &&
+                        !performAction(PlayerAction::Resume) &&
+                        state == GameState::PressStart) {
                         running = false;
                     }
                     break;
@@ -366,414 +335,263 @@ void Game::handleInput() {
     }
 }
 
-void Game::startLevel() {
-    resetPositions();
-    dotsEaten = 0;
-    fruitVisible = false;
-    fruitEaten = false;
-    fruitRespawnTimer = 0.0f;
-    frightenedTimer = 0.0f;
-    ghostsEatenInFright = 0;
-    floatingScores.clear();
-    
-    // Reset waka state
-    wakaTimer = 0.0f;
-    wakaPlaying = false;
-    
-    inScatterMode = true;
-    scatterChasePhase = 0;
-    scatterChaseTimer = SCATTER_TIMES[0];
-    
-    state = GameState::Ready;
-    stateTimer = READY_TIME;
-}
-
-void Game::resetPositions() {
-    pacman.reset();
-    pacman.setSpeedMultiplier(getSpeedMultiplier());
+bool Game::performAction(PlayerAction action) {
+    bool applied = false;
     
-    for (auto& ghost : ghosts) {
-        ghost.reset();
-        ghost.setSpeedMultiplier(getSpeedMultiplier());
-    }
-}
-
-void Game::update(float dt) {
-    blinkTimer += dt;
-    if (blinkTimer >= 0.3f) {
-        blinkTimer = 0.0f;
-        blinkState = !blinkState;
-    }
-    
-    updateHighScoreBlink(dt);
-    
-    if (highScoreResetBlinkTimer > 0.0f) {
-        highScoreResetBlinkTimer -= dt;
-        static float resetBlinkAccum = 0.0f;
-        resetBlinkAccum += dt;
-        if (resetBlinkAccum >= 0.1f) {
-            resetBlinkAccum = 0.0f;
-            highScoreResetBlinkState = !highScoreResetBlinkState;
-        }
-        if (highScoreResetBlinkTimer <= 0.0f) {
-            highScoreResetBlinkState = false;
-        }
-    }
-    
-    switch (state) {
-        case GameState::PressStart:
-            break;
-            
-        case GameState::Startup:
-            stateTimer += dt;
-            if (!AudioManager::get().isPlaying(SoundID::Startup) && stateTimer > 0.5f) {
-                startLevel();
-            }
-            break;
-            
-        case GameState::Ready:
-            stateTimer -= dt;
-            if (stateTimer <= 0.0f) {
-                state = GameState::Playing;
-                AudioManager::get().playSiren(false);
+    switch (action) {
+        case PlayerAction::Up:    applied = core.setDesiredDirection(Direction::Up); break;
+        case PlayerAction::Down:  applied = core.setDesiredDirection(Direction::Down); break;
+        case PlayerAction::Left:  applied = core.setDesiredDirection(Direction::Left); break;
+        case PlayerAction::Right: applied = core.setDesiredDirection(Direction::Right); break;
+        
+        case PlayerAction::Start:
+            applied = core.startGame();
+            if (applied) {
+                AudioManager::get().playSound(SoundID::Startup);
             }
             break;
-            
-        case GameState::Playing:
-            updatePlaying(dt);
-            break;
-            
-        case GameState::Paused:
-            break;
-            
-        case GameState::GhostEaten:
-            freezeTimer -= dt;
-            if (freezeTimer <= 0.0f) {
-                state = GameState::Playing;
-                if (frightenedTimer <= 0.0f) {
-                    AudioManager::get().playSiren(sirenFast);
-                }
+        
+        case PlayerAction::NewGame:
+            if (core.getState() == GameState::GameOver) {
+                highScoreBlinkTimer = 0.0f;
+                highScoreBlinkAccum = 0.0f;
+                highScoreBlinkState = false;
+                core.newGame();
+                applied = true;
             }
-            updateFloatingScores(dt);
             break;
-            
-        case GameState::PreDeath:
-            freezeTimer -= dt;
-            if (freezeTimer <= 0.0f) {
-                state = GameState::Death;
-                AudioManager::get().playSound(SoundID::Death);
-                pacman.die();
+        
+        case PlayerAction::Pause:
+            applied = core.pause();
+            if (applied) {
+                // Detener todos los sonidos de juego
+                stopGameplaySounds();
+                AudioManager::get().playSound(SoundID::Pause);
             }
             break;
-            
-        case GameState::Death:
-            pacman.updateDeathAnimation(dt);
-            if (pacman.isDeathAnimationComplete()) {
-                lives--;
-                if (lives <= 0) {
-                    state = GameState::GameOver;
-                    saveHighScore();
+        
+        case PlayerAction::Resume:
+            applied = core.resume();
+            if (applied) {
+                AudioManager::get().playSound(SoundID::Unpause);
+                // Reanudar sonido apropiado según estado
+                if (core.isFrightened()) {
+                    AudioManager::get().playSound(SoundID::PowerUp, -1);
+                    frightenedAudio = true;
+                } else {
+                    AudioManager::get().playSiren(core.isSirenFast());
                 }
-                else {
-                    resetPositions();
-                    state = GameState::Ready;
-                    stateTimer = READY_TIME;
+                if (core.anyGhostEyes()) {
+                    AudioManager::get().playSound(SoundID::BackToBase, -1);
                 }
             }
             break;
-            
-        case GameState::LevelClear:
-            updateLevelClearAnimation(dt);
-            break;
-            
-        case GameState::GameOver:
-            break;
     }
-}
-
-void Game::updateLevelClearAnimation(float dt) {
-    levelClearTimer += dt;
-    levelClearBlinkTimer += dt;
     
-    if (levelClearBlinkTimer >= LEVEL_CLEAR_BLINK_SPEED) {
-        levelClearBlinkTimer = 0.0f;
-        levelClearBlinkState = !levelClearBlinkState;
+    // Solo se graban las entradas que cambiaron algo
+    if (applied && !playback) {
+        recording.record(core.getTick(), action);
     }
-    
-    if (levelClearTimer >= LEVEL_CLEAR_DURATION) {
-        level++;
-        
-        if (collectedFruits.size() >= 7) {
-            collectedFruits.erase(collectedFruits.begin());
-        }
-        FruitInfo fruitInfo = getCurrentFruitInfo();
-        collectedFruits.push_back(fruitInfo.type);
-        
-        Map::get().resetLevel();
-        startLevel();
+    return applied;
+}
+
+void Game::setAutopilot(const AutopilotConfig& config) {
+    autopilotConfig = config;
+    autopilot.reset(new Autopilot(autopilotConfig));
+    autopilotEnabled = true;
+}
+
+void Game::setProfileOutput(const std::string& path, double seconds, bool dumpOnExit) {
+    profilePath = path;
+    profileSeconds = seconds;
+    profileOnExit = dumpOnExit;
+}
+
+void Game::dumpProfile() {
+    if (Profiler::dumpChromeTrace(profilePath, profileSeconds)) {
+        std::cout << "Profile written: " << profilePath << std::endl;
+    } else {
+        std::cerr << "Could not write profile: " << profilePath << std::endl;
     }
 }
 
-void Game::updatePlaying(float dt) {
-    updateScatterChaseMode(dt);
-    
-    pacman.update(dt);
+void Game::setRecordPath(const std::string& path) {
+    recordPath = path;
+}
+
+void Game::setSeed(uint32_t seed) {
+    core.setSeed(seed);
+    recording.begin(seed, core.getLevel());
+}
+
+bool Game::startReplay(const std::string& path) {
+    if (!playbackReplay.load(path))
+        return false;
     
-    // Manejo de sonido waka con timer
-    if (pacman.ateDot || pacman.atePowerPellet) {
-        wakaTimer = WAKA_TIMEOUT;  // Reiniciar timer
-        if (!wakaPlaying) {
-            AudioManager::get().playSound(SoundID::Waka, -1);  // Loop
-            wakaPlaying = true;
+    core.setSeed(playbackReplay.seed);
+    core.setStartLevel(playbackReplay.level);
+    playback.reset(new ReplayPlayer(playbackReplay));
+    return true;
+}
+
+void Game::update(float dt) {
+    PROFILE_ZONE("Game::update");
+    // Replay en tiempo real: aplicar las entradas de este tick
+    if (playback) {
+        if (playback->isFinished(core.getTick())) {
+            running = false;
+            return;
         }
-    } else {
-        // Decrementar timer si no está comiendo
-        if (wakaPlaying) {
-            wakaTimer -= dt;
-            if (wakaTimer <= 0.0f) {
-                AudioManager::get().stopSound(SoundID::Waka);
-                wakaPlaying = false;
-            }
+        playback->applyDue(core.getTick(), [this](PlayerAction a) { performAction(a); });
+    }
+    else if (autopilotEnabled) {
+        // Las decisiones del piloto pasan por performAction y quedan grabadas
+        switch (autopilot->decide(core)) {
+            case Direction::Up:    performAction(PlayerAction::Up); break;
+            case Direction::Down:  performAction(PlayerAction::Down); break;
+            case Direction::Left:  performAction(PlayerAction::Left); break;
+            case Direction::Right: performAction(PlayerAction::Right); break;
+            default: break;
         }
     }
     
-    if (pacman.ateDot) {
-        score += SCORE_DOT;
-        dotsEaten++;
-        checkHighScore();
-        spawnFruit();
-    }
-    
-    if (pacman.atePowerPellet) {
-        score += SCORE_POWER_PELLET;
-        dotsEaten++;
-        checkHighScore();
-        activateFrightenedMode();
-        spawnFruit();
+    blinkTimer += dt;
+    if (blinkTimer >= 0.3f) {
+        blinkTimer = 0.0f;
+        blinkState = !blinkState;
     }
     
-    updateFloatingScores(dt);
+    updateHighScoreBlink(dt);
     
-    if (frightenedTimer > 0.0f) {
-        frightenedTimer -= dt;
-        
-        bool shouldBlink = frightenedTimer <= FRIGHTENED_BLINK_TIME;
-        for (auto& ghost : ghosts) {
-            if (ghost.getMode() == GhostMode::Frightened) {
-                ghost.setBlinking(shouldBlink);
-            }
-        }
-        
-        if (frightenedTimer <= 0.0f) {
-            for (auto& ghost : ghosts) {
-                if (ghost.getMode() == GhostMode::Frightened) {
-                    ghost.setMode(inScatterMode ? GhostMode::Scatter : GhostMode::Chase);
-                    ghost.setBlinking(false);
-                }
-            }
-            ghostsEatenInFright = 0;
-            // Detener PowerUp y reanudar sirena
-            AudioManager::get().stopSound(SoundID::PowerUp);
-            AudioManager::get().playSiren(sirenFast);
+    if (highScoreResetBlinkTimer > 0.0f) {
+        highScoreResetBlinkTimer -= dt;
+        highScoreResetBlinkAccum += dt;
+        if (highScoreResetBlinkAccum >= 0.1f) {
+            highScoreResetBlinkAccum = 0.0f;
+            highScoreResetBlinkState = !highScoreResetBlinkState;
         }
-    }
-    
-    bool anyEyes = false;
-    for (auto& ghost : ghosts) {
-        if (ghost.getMode() == GhostMode::Eyes) {
-            anyEyes = true;
-            break;
+        if (highScoreResetBlinkTimer <= 0.0f) {
+            highScoreResetBlinkState = false;
         }
     }
     
-    if (anyEyes) {
-        if (!AudioManager::get().isPlaying(SoundID::BackToBase)) {
-            AudioManager::get().playSound(SoundID::BackToBase, -1);
-        }
-    } else {
-        AudioManager::get().stopSound(SoundID::BackToBase);
-    }
+    GameState stateBefore = core.getState();
+    dotEatenThisFrame = false;
     
-    Ghost* blinky = &ghosts[0];
-    for (auto& ghost : ghosts) {
-        Vector2 target = GhostAI::getTarget(ghost, pacman, blinky);
-        ghost.setTarget(target);
-        ghost.update(dt);
+    // Guardar estado anterior para la interpolación del render
+    prevPacmanPosition = core.getPacman().getPixelPosition();
+    const auto& ghosts = core.getGhosts();
+    prevGhostPositions.resize(ghosts.size());
+    for (size_t i = 0; i < ghosts.size(); i++) {
+        prevGhostPositions[i] = ghosts[i].getPixelPosition();
     }
     
-    checkCollisions();
-    updateSiren();
-    checkLevelComplete();
+    core.update();
+    processEvents();
     
-    if (fruitVisible) {
-        fruitTimer -= dt;
-        if (fruitTimer <= 0.0f) {
-            fruitVisible = false;
-        }
+    if (stateBefore == GameState::Playing) {
+        updateWaka(dt);
     }
     
-    if (fruitEaten && !fruitVisible) {
-        fruitRespawnTimer += dt;
-        if (fruitRespawnTimer >= FRUIT_RESPAWN_TIME) {
-            fruitVisible = true;
-            fruitTimer = FRUIT_VISIBLE_TIME;
-            fruitRespawnTimer = 0.0f;
-            fruitEaten = false;
-        }
+    if (stateBefore == GameState::Playing || stateBefore == GameState::GhostEaten) {
+        updateFloatingScores(dt);
     }
 }
 
-void Game::checkHighScore() {
-    if (previousHighScore > 0 && !highScoreBeaten && score > previousHighScore) {
-        highScoreBeaten = true;
-        highScoreBlinkTimer = 2.0f;
-        AudioManager::get().playSound(SoundID::HighScore);
-    }
-    
-    if (score > highScore) {
-        highScore = score;
+void Game::updateWaka(float dt) {
+    // Decrementar timer si no está comiendo
+    if (!dotEatenThisFrame && wakaPlaying) {
+        wakaTimer -= dt;
+        if (wakaTimer <= 0.0f) {
+            AudioManager::get().stopSound(SoundID::Waka);
+            wakaPlaying = false;
+        }
     }
 }
 
-void Game::updateHighScoreBlink(float dt) {
-    if (highScoreBlinkTimer > 0.0f) {
-        highScoreBlinkTimer -= dt;
-        
-        highScoreBlinkAccum += dt;
-        if (highScoreBlinkAccum >= 0.1f) {
-            highScoreBlinkAccum = 0.0f;
-            highScoreBlinkState = !highScoreBlinkState;
-        }
-        
-        if (highScoreBlinkTimer <= 0.0f) {
-            highScoreBlinkState = false;
-            highScoreBlinkAccum = 0.0f;
-        }
-    }
+void Game::stopGameplaySounds() {
+    AudioManager::get().stopSiren();
+    AudioManager::get().stopSound(SoundID::Waka);
+    AudioManager::get().stopSound(SoundID::PowerUp);
+    AudioManager::get().stopSound(SoundID::BackToBase);
+    wakaPlaying = false;
+    frightenedAudio = false;
 }
 
-void Game::updateScatterChaseMode(float dt) {
-    if (frightenedTimer > 0.0f)
-        return;
-    
-    scatterChaseTimer -= dt;
-    
-    if (scatterChaseTimer <= 0.0f) {
-        inScatterMode = !inScatterMode;
-        
-        if (!inScatterMode) {
-            scatterChaseTimer = CHASE_TIMES[scatterChasePhase];
-        }
-        else {
-            scatterChasePhase++;
-            if (scatterChasePhase >= 4) scatterChasePhase = 3;
-            scatterChaseTimer = SCATTER_TIMES[scatterChasePhase];
-        }
+// ===== EVENTOS DE GAMECORE =====
+
+void Game::processEvents() {
+    core.getEvents().drain([this](const GameEvent& e) {
+        // Posición en píxeles del tile del evento (puntajes flotantes)
+        float x = static_cast<float>(e.tileX * SCALED_TILE);
+        float y = static_cast<float>(e.tileY * SCALED_TILE);
         
-        GhostMode newMode = inScatterMode ? GhostMode::Scatter : GhostMode::Chase;
-        for (auto& ghost : ghosts) {
-            if (ghost.getMode() != GhostMode::Frightened && 
-                ghost.getMode() != GhostMode::Eyes) {
-                ghost.setMode(newMode);
-            }
+        switch (e.type) {
+            case GameEventType::LevelStarted:          onLevelStarted(); break;
+            case GameEventType::PlayingStarted:        onPlayingStarted(); break;
+            case GameEventType::DotEaten:
+            case GameEventType::PelletEaten:           onDotEaten(); break;
+            case GameEventType::FruitEaten:            onFruitEaten(core.getCurrentFruitInfo(), x, y); break;
+            case GameEventType::GhostEaten:            onGhostEaten(e.value, x, y); break;
+            case GameEventType::GhostEatenFreezeEnded: onGhostEatenFreezeEnded(); break;
+            case GameEventType::ModeChanged:
+                // Scatter <-> Chase no cambia el audio; solo entrar y salir de Frightened
+                if (e.value == static_cast<int>(GhostMode::Frightened)) {
+                    frightenedAudio = true;
+                    onFrightenedStarted();
+                }
+                else if (frightenedAudio) {
+                    frightenedAudio = false;
+                    onFrightenedEnded();
+                }
+                break;
+            case GameEventType::EyesReturning:         onEyesReturningChanged(e.value != 0); break;
+            case GameEventType::SirenChanged:          onSirenSpeedChanged(e.value != 0); break;
+            case GameEventType::HighScoreBeaten:       onHighScoreBeaten(); break;
+            case GameEventType::Death:                 onPacmanCaught(); break;
+            case GameEventType::DeathAnimationStarted: onDeathAnimationStarted(); break;
+            case GameEventType::LevelClear:            onLevelClear(); break;
+            case GameEventType::GameOver:              onGameOver(); break;
         }
-    }
+    });
 }
 
-void Game::activateFrightenedMode() {
-    frightenedTimer = FRIGHTENED_TIME;
-    ghostsEatenInFright = 0;
+void Game::onLevelStarted() {
+    floatingScores.clear();
     
-    for (auto& ghost : ghosts) {
-        if (ghost.getMode() != GhostMode::Eyes) {
-            ghost.setMode(GhostMode::Frightened);
-        }
+    // Reset waka state
+    wakaTimer = 0.0f;
+    wakaPlaying = false;
+}
+
+void Game::onPlayingStarted() {
+    AudioManager::get().playSiren(false);
+}
+
+void Game::onDotEaten() {
+    dotEatenThisFrame = true;
+    wakaTimer = WAKA_TIMEOUT;  // Reiniciar timer
+    if (!wakaPlaying) {
+        AudioManager::get().playSound(SoundID::Waka, -1);  // Loop
+        wakaPlaying = true;
     }
-    
+}
+
+void Game::onFrightenedStarted() {
     // Detener sirena y reproducir PowerUp en loop
     AudioManager::get().stopSiren();
     AudioManager::get().playSound(SoundID::PowerUp, -1);  // -1 = loop infinito
 }
 
-void Game::checkCollisions() {
-    int pacTileX = pacman.getTileX();
-    int pacTileY = pacman.getTileY();
-    
-    for (auto& ghost : ghosts) {
-        int ghostTileX = ghost.getTileX();
-        int ghostTileY = ghost.getTileY();
-        
-        if (pacTileX == ghostTileX && pacTileY == ghostTileY) {
-            if (ghost.getMode() == GhostMode::Frightened) {
-                eatGhost(ghost);
-                return;
-            }
-            else if (ghost.getMode() != GhostMode::Eyes) {
-                pacmanDied();
-                return;
-            }
-        }
-    }
-    
-    if (fruitVisible) {
-        float fruitX = 13.5f * SCALED_TILE;
-        float fruitY = 17.0f * SCALED_TILE;
-        
-        float pacCenterX = pacman.position.x + SCALED_TILE / 2.0f;
-        float pacCenterY = pacman.position.y + SCALED_TILE / 2.0f;
-        
-        float dx = pacCenterX - fruitX;
-        float dy = pacCenterY - fruitY;
-        float distance = std::sqrt(dx * dx + dy * dy);
-        
-        if (distance < SCALED_TILE * 0.6f) {
-            FruitInfo fruitInfo = getCurrentFruitInfo();
-            score += fruitInfo.points;
-            checkHighScore();
-            
-            // Usar sprite de puntaje
-            addFloatingScore(fruitInfo.pointsTextureKey, pacman.position.x, pacman.position.y);
-            
-            AudioManager::get().playSound(SoundID::Fruit);
-            
-            fruitVisible = false;
-            fruitEaten = true;
-            fruitRespawnTimer = 0.0f;
-        }
-    }
+void Game::onFrightenedEnded() {
+    // Detener PowerUp y reanudar sirena
+    AudioManager::get().stopSound(SoundID::PowerUp);
+    AudioManager::get().playSiren(core.isSirenFast());
 }
 
-void Game::eatGhost(Ghost& ghost) {
-    int points;
-    std::string pointsTexture;
-    
-    switch (ghostsEatenInFright) {
-        case 0: 
-            points = SCORE_GHOST_1; 
-            pointsTexture = "points_ghost_200";
-            break;
-        case 1: 
-            points = SCORE_GHOST_2; 
-            pointsTexture = "points_ghost_400";
-            break;
-        case 2: 
-            points = SCORE_GHOST_3; 
-            pointsTexture = "points_ghost_800";
-            break;
-        default: 
-            points = SCORE_GHOST_4; 
-            pointsTexture = "points_ghost_1600";
-            break;
-    }
-    
-    score += points;
-    checkHighScore();
-    ghostsEatenInFright++;
-    
+void Game::onGhostEaten(int comboIndex, float x, float y) {
     // Usar sprite de puntaje
-    addFloatingScore(pointsTexture, ghost.position.x, ghost.position.y);
-    
-    ghost.sendToHouse();
+    addFloatingScore(ghostPointsSprites[std::min(std::max(comboIndex, 0), GHOST_COMBO_SPRITES - 1)], x, y);
     
     // Detener waka pero NO PowerUp (debe seguir sonando)
     AudioManager::get().stopSound(SoundID::Waka);
@@ -781,57 +599,78 @@ void Game::eatGhost(Ghost& ghost) {
     
     AudioManager::get().playSound(SoundID::GhostEaten);
     AudioManager::get().playSound(SoundID::BackToBase, -1);
-    
-    state = GameState::GhostEaten;
-    freezeTimer = FREEZE_TIME;
 }
 
-void Game::pacmanDied() {
-    AudioManager::get().stopSiren();
-    AudioManager::get().stopSound(SoundID::Waka);
-    AudioManager::get().stopSound(SoundID::PowerUp);
-    AudioManager::get().stopSound(SoundID::BackToBase);
-    wakaPlaying = false;
-    
-    state = GameState::PreDeath;
-    freezeTimer = FREEZE_TIME;
+void Game::onGhostEatenFreezeEnded() {
+    if (!core.isFrightened()) {
+        AudioManager::get().playSiren(core.isSirenFast());
+    }
 }
 
-void Game::checkLevelComplete() {
-    if (Map::get().getRemainingDots() <= 0) {
-        state = GameState::LevelClear;
-        levelClearTimer = 0.0f;
-        levelClearBlinkTimer = 0.0f;
-        levelClearBlinkState = false;
-        
-        AudioManager::get().stopSiren();
-        AudioManager::get().stopSound(SoundID::Waka);
-        AudioManager::get().stopSound(SoundID::PowerUp);
+void Game::onEyesReturningChanged(bool returning) {
+    if (returning) {
+        if (!AudioManager::get().isPlaying(SoundID::BackToBase)) {
+            AudioManager::get().playSound(SoundID::BackToBase, -1);
+        }
+    } else {
         AudioManager::get().stopSound(SoundID::BackToBase);
-        wakaPlaying = false;
     }
 }
 
-void Game::spawnFruit() {
-    if ((dotsEaten == 70 || dotsEaten == 170) && !fruitVisible && !fruitEaten) {
-        fruitVisible = true;
-        fruitTimer = FRUIT_VISIBLE_TIME;
-    }
+void Game::onFruitEaten(const FruitInfo& fruit, float x, float y) {
+    // Usar sprite de puntaje
+    addFloatingScore(fruitPointsSprites[static_cast<int>(fruit.type)], x, y);
+    AudioManager::get().playSound(SoundID::Fruit);
 }
 
-void Game::updateSiren() {
-    int remaining = Map::get().getRemainingDots();
-    bool shouldBeFast = remaining < 30;
-    
-    if (shouldBeFast != sirenFast && frightenedTimer <= 0.0f) {
-        sirenFast = shouldBeFast;
-        AudioManager::get().playSiren(sirenFast);
+void Game::onSirenSpeedChanged(bool fast) {
+    AudioManager::get().playSiren(fast);
+}
+
+void Game::onHighScoreBeaten() {
+    highScoreBlinkTimer = 2.0f;
+    AudioManager::get().playSound(SoundID::HighScore);
+}
+
+void Game::onPacmanCaught() {
+    stopGameplaySounds();
+}
+
+void Game::onDeathAnimationStarted() {
+    AudioManager::get().playSound(SoundID::Death);
+}
+
+void Game::onLevelClear() {
+    stopGameplaySounds();
+}
+
+void Game::onGameOver() {
+    saveHighScore();
+}
+
+void Game::updateHighScoreBlink(float dt) {
+    if (highScoreBlinkTimer > 0.0f) {
+        highScoreBlinkTimer -= dt;
+        
+        highScoreBlinkAccum += dt;
+        if (highScoreBlinkAccum >= 0.1f) {
+            highScoreBlinkAccum = 0.0f;
+            highScoreBlinkState = !highScoreBlinkState;
+        }
+        
+        if (highScoreBlinkTimer <= 0.0f) {
+            highScoreBlinkState = false;
+            highScoreBlinkAccum = 0.0f;
+        }
     }
 }
 
-void Game::addFloatingScore(const std::string& textureKey, float x, float y) {
+void Game::addFloatingScore(const Sprite* sprite, float x, float y) {
+    if (!sprite)
+        return;
+    
     FloatingScore fs;
-    fs.textureKey = textureKey;
+    fs.sprite = sprite;
     fs.x = x;
     fs.y = y;
     fs.timer = FLOATING_SCORE_TIME;
@@ -864,31 +703,25 @@ void Game::renderFloatingScores() {
     for (const auto& fs : floatingScores) {
         if (!fs.active) continue;
         
-        SDL_Texture* tex = tm.getTexture(fs.textureKey);
-        if (tex) {
-            int w, h;
-            SDL_QueryTexture(tex, nullptr, nullptr, &w, &h);
-            
-            // Escalar el sprite de puntaje
-            int drawW = w * SCALE;
-            int drawH = h * SCALE;
-            
-            int x = static_cast<int>(fs.x) - drawW / 2 + SCALED_TILE / 2;
-            int y = static_cast<int>(fs.y) + GAME_OFFSET_Y - drawH / 2;
-            
-            tm.draw(fs.textureKey, x, y, drawW, drawH);
-        }
+        // Escalar el sprite de puntaje
+        int drawW = fs.sprite->src.w * SCALE;
+        int drawH = fs.sprite->src.h * SCALE;
+        
+        int x = static_cast<int>(fs.x) - drawW / 2 + SCALED_TILE / 2;
+        int y = static_cast<int>(fs.y) + GAME_OFFSET_Y - drawH / 2;
+        
+        tm.draw(*fs.sprite, x, y, drawW, drawH);
     }
 }
 
 void Game::drawPausedText() {
     auto& tm = TextureManager::get();
-    SDL_Texture* pauseTex = tm.getTexture("text_pause");
+    const Sprite* pause = pauseSprite;
     
-    if (pauseTex) {
-        int w, h;
-        SDL_QueryTexture(pauseTex, nullptr, nullptr, &w, &h);
-        tm.draw("text_pause", 
+    if (pause) {
+        int w = pause->src.w;
+        int h = pause->src.h;
+        tm.draw(*pause,
             SCREEN_WIDTH / 2 - (w * SCALE) / 2,
             SCREEN_HEIGHT / 2 - (h * SCALE) / 2,
             w * SCALE, h * SCALE);
@@ -900,9 +733,9 @@ void Game::renderHUD() {
     
     auto& tm = TextureManager::get();
     
-    for (int i = 0; i < lives - 1; i++) {
+    for (int i = 0; lifeSprite && i < core.getLives() - 1; i++) {
         int x = SCALED_TILE + i * (SCALED_TILE + 4);
-        tm.draw("pacman_life", x, hudY, SCALED_TILE, SCALED_TILE);
+        tm.draw(*lifeSprite, x, hudY, SCALED_TILE, SCALED_TILE);
     }
     
     renderFruitDisplay();
@@ -912,38 +745,40 @@ void Game::renderFruitDisplay() {
     auto& tm = TextureManager::get();
     int hudY = SCREEN_HEIGHT - SCALED_TILE - 4;
     
-    std::vector<std::string> fruitsToShow;
-    
-    // Mostrar frutas según nivel alcanzado (máximo 7 frutas visibles)
-    for (int lvl = 1; lvl <= level && fruitsToShow.size() < 7; lvl++) {
-        fruitsToShow.push_back(getFruitTextureForLevel(lvl));
-    }
-    
-    // Dibujar de derecha a izquierda
+    // Mostrar frutas según nivel alcanzado (máximo 7 frutas visibles),
+    // de derecha a izquierda
+    int shown = std::min(core.getLevel(), 7);
     int startX = SCREEN_WIDTH - SCALED_TILE - 4;
-    for (int i = static_cast<int>(fruitsToShow.size()) - 1; i >= 0; i--) {
-        int x = startX - (static_cast<int>(fruitsToShow.size()) - 1 - i) * (SCALED_TILE + 4);
-        tm.draw(fruitsToShow[i], x, hudY, SCALED_TILE, SCALED_TILE);
+    for (int i = 0; i < shown; i++) {
+        const Sprite* sprite = fruitSprites[static_cast<int>(GameCore::getFruitInfo(i + 1).type)];
+        if (!sprite) continue;
+        int x = startX - (shown - 1 - i) * (SCALED_TILE + 4);
+        tm.draw(*sprite, x, hudY, SCALED_TILE, SCALED_TILE);
     }
 }
 
-void Game::render() {
+void Game::render(float alpha) {
+    PROFILE_ZONE("Game::render");
+    renderAlpha = alpha;
+    GameState state = core.getState();
+    const PacMan& pacman = core.getPacman();
+    
     renderer.clear();
     
     if (state == GameState::LevelClear) {
         renderLevelClearAnimation();
     }
     else {
-        renderer.drawMaze();
-        renderer.drawDots();
+        renderer.drawMaze(core.getMap());
+        renderer.drawDots(core.getMap());
     }
     
-    if (fruitVisible && state != GameState::LevelClear) {
-        FruitInfo fruitInfo = getCurrentFruitInfo();
+    const Sprite* fruit = fruitSprites[static_cast<int>(core.getCurrentFruitInfo().type)];
+    if (core.isFruitVisible() && state != GameState::LevelClear && fruit) {
         TextureManager::get().draw(
-            fruitInfo.textureKey,
-            13 * SCALED_TILE,
-            17 * SCALED_TILE + GAME_OFFSET_Y,
+            *fruit,
+            FRUIT_TILE_X * SCALED_TILE,
+            FRUIT_TILE_Y * SCALED_TILE + GAME_OFFSET_Y,
             SCALED_TILE,
             SCALED_TILE
         );
@@ -954,32 +789,37 @@ void Game::render() {
     
     if (showPacman) {
         if (state != GameState::Death || !pacman.isDeathAnimationComplete()) {
-            std::string pacTexture;
-            double angle = 0;
+            const Sprite* sprite = nullptr;
             
             if (state == GameState::Death) {
-                pacTexture = "pacman_death_" + std::to_string(pacman.getDeathFrame());
+                int frame = pacman.getDeathFrame();
+                if (frame >= 0 && frame < PACMAN_DEATH_FRAMES) sprite = pacmanDeathSprites[frame];
             }
             else {
-                pacTexture = "pacman_" + std::to_string(pacman.getAnimFrame());
-                
+                // Frames ya girados en el atlas (en lugar de rotar en cada frame)
+                int turns = 0;
                 switch (pacman.direction) {
-                    case Direction::Right: angle = 0;   break;
-                    case Direction::Down:  angle = 90;  break;
-                    case Direction::Left:  angle = 180; break;
-                    case Direction::Up:    angle = 270; break;
+                    case Direction::Right: turns = 0; break;
+                    case Direction::Down:  turns = 1; break;
+                    case Direction::Left:  turns = 2; break;
+                    case Direction::Up:    turns = 3; break;
                     default: break;
                 }
+                int frame = pacman.getAnimFrame();
+                if (frame >= 0 && frame < PACMAN_ANIM_FRAMES) sprite = pacmanSprites[frame][turns];
             }
             
-            TextureManager::get().draw(
-                pacTexture,
-                static_cast<int>(pacman.position.x),
-                static_cast<int>(pacman.position.y) + GAME_OFFSET_Y,
-                SCALED_TILE,
-                SCALED_TILE,
-                angle
-            );
+            Vector2 pos = interpolate(prevPacmanPosition, pacman.getPixelPosition());
+            
+            if (sprite) {
+                TextureManager::get().draw(
+                    *sprite,
+                    static_cast<int>(pos.x),
+                    static_cast<int>(pos.y) + GAME_OFFSET_Y,
+                    SCALED_TILE,
+                    SCALED_TILE
+                );
+            }
         }
     }
     
@@ -989,8 +829,10 @@ void Game::render() {
                        state != GameState::LevelClear);
     
     if (showGhosts) {
-        for (auto& ghost : ghosts) {
-            ghost.render(renderer.getSDLRenderer());
+        const auto& ghosts = core.getGhosts();
+        for (size_t i = 0; i < ghosts.size(); i++) {
+            Vector2 prev = (i < prevGhostPositions.size()) ? prevGhostPositions[i] : ghosts[i].getPixelPosition();
+            renderGhost(ghosts[i], prev);
         }
     }
     
@@ -999,54 +841,22 @@ void Game::render() {
     bool shouldBlinkScore = (highScoreBlinkTimer > 0.0f && highScoreBlinkState);
     bool shouldBlinkHighScoreReset = (highScoreResetBlinkTimer > 0.0f && highScoreResetBlinkState);
     
-    renderer.drawScore(score, highScore, lives, shouldBlinkScore || shouldBlinkHighScoreReset);
+    renderer.drawScore(core.getScore(), core.getHighScore(), core.getLives(), shouldBlinkScore || shouldBlinkHighScoreReset);
     
     renderHUD();
     renderVolumeIcon();
     
-    auto& tm = TextureManager::get();
-    
     if (state == GameState::PressStart) {
-        if (blinkState) {
-            SDL_Texture* tex = tm.getTexture("text_pressstart");
-            if (tex) {
-                int w, h;
-                SDL_QueryTexture(tex, nullptr, nullptr, &w, &h);
-                int x = SCREEN_WIDTH / 2 - (w * SCALE) / 2;
-                int y = 17 * SCALED_TILE + GAME_OFFSET_Y;
-                renderer.drawText("text_pressstart", x, y);
-            }
-        }
+        if (blinkState) drawCenteredText(pressStartSprite);
     }
     else if (state == GameState::Ready) {
-        SDL_Texture* tex = tm.getTexture("text_ready");
-        if (tex) {
-            int w, h;
-            SDL_QueryTexture(tex, nullptr, nullptr, &w, &h);
-            int x = SCREEN_WIDTH / 2 - (w * SCALE) / 2;
-            int y = 17 * SCALED_TILE + GAME_OFFSET_Y;
-            renderer.drawText("text_ready", x, y);
-        }
+        drawCenteredText(readySprite);
     }
     else if (state == GameState::GameOver) {
-        SDL_Texture* tex = tm.getTexture("text_gameover");
-        if (tex) {
-            int w, h;
-            SDL_QueryTexture(tex, nullptr, nullptr, &w, &h);
-            int x = SCREEN_WIDTH / 2 - (w * SCALE) / 2;
-            int y = 17 * SCALED_TILE + GAME_OFFSET_Y;
-            renderer.drawText("text_gameover", x, y);
-        }
+        drawCenteredText(gameOverSprite);
     }
     else if (state == GameState::LevelClear) {
-        SDL_Texture* tex = tm.getTexture("text_clear");
-        if (tex) {
-            int w, h;
-            SDL_QueryTexture(tex, nullptr, nullptr, &w, &h);
-            int x = SCREEN_WIDTH / 2 - (w * SCALE) / 2;
-            int y = 17 * SCALED_TILE + GAME_OFFSET_Y;
-            renderer.drawText("text_clear", x, y);
-        }
+        drawCenteredText(clearSprite);
     }
     else if (state == GameState::Paused) {
         drawPausedText();
@@ -1055,19 +865,69 @@ void Game::render() {
     renderer.present();
 }
 
+// Texto centrado en la fila de "READY!"
+void Game::drawCenteredText(const Sprite* sprite) {
+    if (!sprite)
+        return;
+    int x = SCREEN_WIDTH / 2 - (sprite->src.w * SCALE) / 2;
+    int y = 17 * SCALED_TILE + GAME_OFFSET_Y;
+    renderer.drawText(*sprite, x, y);
+}
+
 void Game::renderLevelClearAnimation() {
-    renderer.drawMazeFlashing(levelClearBlinkState);
+    renderer.drawMazeFlashing(core.getMap(), core.isLevelClearFlashOn());
+}
+
+Vector2 Game::interpolate(const Vector2& prev, const Vector2& current) const {
+    // Saltos de más de un tile (túnel, reset de posiciones) no se interpolan
+    float dx = current.x - prev.x;
+    float dy = current.y - prev.y;
+    if (std::abs(dx) > SCALED_TILE || std::abs(dy) > SCALED_TILE) {
+        return current;
+    }
+    
+    return Vector2(prev.x + dx * renderAlpha, prev.y + dy * renderAlpha);
+}
+
+void Game::renderGhost(const Ghost& ghost, const Vector2& prevPosition) {
+    Vector2 pos = interpolate(prevPosition, ghost.getPixelPosition());
+    
+    int dir = ghostSpriteDirection(ghost.direction);
+    int frame = ghost.getAnimFrame() & 1;
+    const Sprite* sprite;
+    switch (ghost.getMode()) {
+        case GhostMode::Eyes:
+            sprite = eyesSprites[dir];
+            break;
+        case GhostMode::Frightened:
+            // Parpadeo al final del susto: frames blancos
+            sprite = frightenedSprites[ghost.isBlinkWhite() ? frame + 2 : frame];
+            break;
+        default:
+            sprite = ghostSprites[static_cast<int>(ghost.getType())][dir][frame];
+            break;
+    }
+    if (!sprite)
+        return;
+    
+    TextureManager::get().draw(
+        *sprite,
+        static_cast<int>(pos.x),
+        static_cast<int>(pos.y) + GAME_OFFSET_Y,
+        SCALED_TILE,
+        SCALED_TILE
+    );
 }
 
 // ===== CONTROL DE VOLUMEN =====
 
-std::string Game::getVolumeTextureKey() const {
+const Sprite* Game::getVolumeSprite() const {
     switch (volumeLevel) {
-        case 100: return "volume_100";
-        case 50:  return "volume_50";
-        case 25:  return "volume_25";
-        case 0:   return "volume_0";
-        default:  return "volume_100";
+        case 100: return volumeSprites[0];
+        case 50:  return volumeSprites[1];
+        case 25:  return volumeSprites[2];
+        case 0:   return volumeSprites[3];
+        default:  return volumeSprites[0];
     }
 }
 
@@ -1100,12 +960,11 @@ void Game::handleVolumeClick(int mouseX, int mouseY) {
 
 void Game::renderVolumeIcon() {
     auto& tm = TextureManager::get();
-    std::string texKey = getVolumeTextureKey();
     
-    SDL_Texture* tex = tm.getTexture(texKey);
-    if (tex) {
-        int w, h;
-        SDL_QueryTexture(tex, nullptr, nullptr, &w, &h);
+    const Sprite* sprite = getVolumeSprite();
+    if (sprite) {
+        int w = sprite->src.w;
+        int h = sprite->src.h;
         
         // Escalar el icono según el tipo (50% para sonido, 25% para mudo)
         float scale = (volumeLevel == 0) ? 0.5f : 1.0f;
@@ -1119,6 +978,6 @@ void Game::renderVolumeIcon() {
         // Actualizar el rectángulo clickeable
         volumeIconRect = {iconX, iconY, iconW, iconH};
         
-        tm.draw(texKey, iconX, iconY, iconW, iconH);
+        tm.draw(*sprite, iconX, iconY, iconW, iconH);
     }
 }
@@ -2,56 +2,28 @@
 // Clase principal del juego Pac-Man - Versión 3.2.1
 #pragma once
 
-#include "Pacman.h"
-#include "Ghost.h"
+#include "GameCore.h"
+#include "Replay.h"
+#include "Autopilot.h"
 #include "Renderer.h"
 #include "AudioManager.h"
 #include <SDL2/SDL.h>
+#include <memory>
 #include <vector>
 #include <string>
 
-// Estados del juego
-enum class GameState {
-    PressStart,   // Esperando Enter para comenzar
-    Startup,      // Reproduciendo música de inicio
-    Ready,        // Mostrando "READY!"
-    Playing,      // Jugando
-    Paused,       // Juego pausado
-    GhostEaten,   // Congelado después de comer fantasma (0.5 segundos)
-    PreDeath,     // Pausa antes de animación de muerte (0.5 segundos)
-    Death,        // Animación de muerte
-    GameOver,     // Game Over
-    LevelClear    // Nivel completado (parpadeo del mapa)
-};
-
-// Tipos de fruta (8 frutas total)
-enum class FruitType {
-    Cherry,      // Nivel 1 - 100 pts
-    Strawberry,  // Nivel 2 - 300 pts
-    Orange,      // Nivel 3-4 - 500 pts
-    Apple,       // Nivel 5-6 - 700 pts
-    Melon,       // Nivel 7-8 - 1000 pts
-    Ship,        // Nivel 9-10 - 2000 pts (Galaxian)
-    Bell,        // Nivel 11-12 - 3000 pts
-    Key          // Nivel 13+ - 5000 pts
-};
-
-// Información de fruta
-struct FruitInfo {
-    FruitType type;
-    std::string textureKey;
-    std::string pointsTextureKey;  // Sprite del puntaje
-    int points;
-};
+struct Sprite;
 
 // Puntaje flotante (ahora usa sprites)
 struct FloatingScore {
-    std::string textureKey;  // Sprite del puntaje a mostrar
+    const Sprite* sprite;  // Sprite del puntaje a mostrar
     float x, y;
     float timer;
     bool active;
 };
 
+// Front end SDL: ventana, audio, texturas y persistencia del high score.
+// La lógica vive en GameCore; aquí solo se reacciona a sus eventos.
 class Game {
 public:
     Game();
@@ -60,113 +32,148 @@ public:
     bool init();
     void handleInput();
     void update(float dt);
-    void render();
+    void render(float alpha = 1.0f);  // alpha: fracción entre el tick anterior y el actual
     
     bool isRunning() const { return running; }
     
+    // Replays: grabar las entradas de esta sesión o reproducir un archivo
+    void setRecordPath(const std::string& path);  // Se guarda al cerrar
+    void setSeed(uint32_t seed);                  // Antes de init(); queda en la grabación
+    bool startReplay(const std::string& path);
+    
+    // Piloto automático (asistencia/demo); Tab lo activa y desactiva
+    void setAutopilot(const AutopilotConfig& config);
+    
+    // Profiling: F12 escribe los últimos segundos como Chrome trace JSON
+    // (y también al salir si dumpOnExit)
+    void setProfileOutput(const std::string& path, double seconds, bool dumpOnExit);
+
 private:
-    GameState state = GameState::PressStart;
-    GameState stateBeforePause = GameState::Playing;
+    // Eventos de GameCore (se vacía la cola en una pasada después de cada update)
+    void processEvents();
+    void onLevelStarted();
+    void onPlayingStarted();
+    void onDotEaten();
+    void onFrightenedStarted();
+    void onFrightenedEnded();
+    void onGhostEaten(int comboIndex, float x, float y);
+    void onGhostEatenFreezeEnded();
+    void onEyesReturningChanged(bool returning);
+    void onFruitEaten(const FruitInfo& fruit, float x, float y);
+    void onSirenSpeedChanged(bool fast);
+    void onHighScoreBeaten();
+    void onPacmanCaught();
+    void onDeathAnimationStarted();
+    void onLevelClear();
+    void onGameOver();
+    
     bool running = true;
     
-    // Timers
-    float stateTimer = 0.0f;
-    float frightenedTimer = 0.0f;
-    float scatterChaseTimer = 0.0f;
-    float fruitTimer = 0.0f;
+    // Simulación
+    GameCore core;
+    
+    // Grabación y reproducción de entradas
+    Replay recording;
+    std::string recordPath;
+    Replay playbackReplay;
+    std::unique_ptr<ReplayPlayer> playback;
+    
+    // Piloto automático (se crea la primera vez que se activa)
+    AutopilotConfig autopilotConfig;
+    std::unique_ptr<Autopilot> autopilot;
+    bool autopilotEnabled = false;
+    
+    // Profiling
+    std::string profilePath = "pacman_trace.json";
+    double profileSeconds = 10.0;
+    bool profileOnExit = false;
+    void dumpProfile();
+    
+    // Posiciones del tick anterior (para interpolar al renderizar)
+    Vector2 prevPacmanPosition;
+    std::vector<Vector2> prevGhostPositions;
+    float renderAlpha = 1.0f;
+    
+    // Parpadeo del texto "PRESS ENTER"
     float blinkTimer = 0.0f;
     bool blinkState = false;
     
-    // Freeze timers (para comer fantasma y pre-muerte)
-    float freezeTimer = 0.0f;
-    static constexpr float FREEZE_TIME = 0.5f;
-    
     // Timer para sonido waka (se detiene si no come en X tiempo)
     float wakaTimer = 0.0f;
     static constexpr float WAKA_TIMEOUT = 0.25f;  // Tiempo antes de detener waka
     bool wakaPlaying = false;
+    bool dotEatenThisFrame = false;
+    bool frightenedAudio = false;  // PowerUp sonando en lugar de la sirena
     
-    // Level Clear animation
-    float levelClearTimer = 0.0f;
-    float levelClearBlinkTimer = 0.0f;
-    bool levelClearBlinkState = false;
-    static constexpr float LEVEL_CLEAR_DURATION = 3.0f;
-    static constexpr float LEVEL_CLEAR_BLINK_SPEED = 0.15f;
-    
-    // Puntuación
-    int score = 0;
-    int highScore = 0;
-    int previousHighScore = 0;
-    bool highScoreBeaten = false;
+    // Parpadeo al superar el high score
     float highScoreBlinkTimer = 0.0f;
     float highScoreBlinkAccum = 0.0f;
     bool highScoreBlinkState = false;
     
     // High score reset
     float highScoreResetBlinkTimer = 0.0f;
+    float highScoreResetBlinkAccum = 0.0f;
     bool highScoreResetBlinkState = false;
     
-    int lives = 3;
-    int level = 1;
-    int dotsEaten = 0;
-    int ghostsEatenInFright = 0;
-    
     // Puntajes flotantes (ahora con sprites)
     std::vector<FloatingScore> floatingScores;
     static constexpr float FLOATING_SCORE_TIME = 1.0f;
     
-    // Modo scatter/chase
-    bool inScatterMode = true;
-    int scatterChasePhase = 0;
-    
-    // Fruta
-    bool fruitVisible = false;
-    bool fruitEaten = false;
-    float fruitRespawnTimer = 0.0f;
-    static constexpr float FRUIT_RESPAWN_TIME = 35.0f;
-    std::vector<FruitType> collectedFruits;
-    
-    // Sirena
-    bool sirenFast = false;
-    
     // Control de volumen
     int volumeLevel = 100;  // 100, 50, 25, 0
     SDL_Rect volumeIconRect;  // Área clickeable del icono
     
-    // Entidades
-    PacMan pacman;
-    std::vector<Ghost> ghosts;
-    
     // Sistemas
     Renderer renderer;
     
+    // Sprites del atlas resueltos en loadAllTextures (nullptr si no cargó):
+    // el render no arma ni busca strings por frame.
+    // Pac-Man: [frame][cuartos de giro horario]
+    static constexpr int PACMAN_ANIM_FRAMES = 5;
+    static constexpr int PACMAN_DEATH_FRAMES = 12;
+    const Sprite* pacmanSprites[PACMAN_ANIM_FRAMES][4] = {};
+    const Sprite* pacmanDeathSprites[PACMAN_DEATH_FRAMES] = {};
+    const Sprite* lifeSprite = nullptr;
+    
+    // Fantasmas: [GhostType][dirección (arriba, abajo, izquierda, derecha)][frame]
+    static constexpr int GHOST_ANIM_FRAMES = 2;
+    static constexpr int FRIGHTENED_FRAMES = 4;  // 0-1 azul, 2-3 blanco (parpadeo)
+    const Sprite* ghostSprites[GhostPersonalities::count][4][GHOST_ANIM_FRAMES] = {};
+    const Sprite* frightenedSprites[FRIGHTENED_FRAMES] = {};
+    const Sprite* eyesSprites[4] = {};
+    
+    // Frutas y puntajes: [FruitType] y [combo de fantasmas comidos]
+    static constexpr int FRUIT_TYPES = 8;
+    static constexpr int GHOST_COMBO_SPRITES = 4;
+    const Sprite* fruitSprites[FRUIT_TYPES] = {};
+    const Sprite* fruitPointsSprites[FRUIT_TYPES] = {};
+    const Sprite* ghostPointsSprites[GHOST_COMBO_SPRITES] = {};
+    
+    // Textos y volumen ([100, 50, 25, 0])
+    const Sprite* readySprite = nullptr;
+    const Sprite* gameOverSprite = nullptr;
+    const Sprite* clearSprite = nullptr;
+    const Sprite* pressStartSprite = nullptr;
+    const Sprite* pauseSprite = nullptr;
+    const Sprite* volumeSprites[4] = {};
+    
     // Métodos
+    bool performAction(PlayerAction action);  // true si cambió el estado del juego
     void loadAllTextures();
-    void startLevel();
-    void resetPositions();
-    void updatePlaying(float dt);
-    void checkCollisions();
-    void activateFrightenedMode();
-    void updateScatterChaseMode(float dt);
-    void updateSiren();
-    void eatGhost(Ghost& ghost);
-    void pacmanDied();
-    void checkLevelComplete();
-    void spawnFruit();
-    void addFloatingScore(const std::string& textureKey, float x, float y);
+    void stopGameplaySounds();
+    void updateWaka(float dt);
+    void addFloatingScore(const Sprite* sprite, float x, float y);
     void updateFloatingScores(float dt);
     void renderFloatingScores();
+    void renderGhost(const Ghost& ghost, const Vector2& prevPosition);
+    Vector2 interpolate(const Vector2& prev, const Vector2& current) const;
     void drawPausedText();
     
-    // Métodos de frutas y niveles
-    FruitInfo getCurrentFruitInfo() const;
-    float getSpeedMultiplier() const;
-    void updateLevelClearAnimation(float dt);
     void renderLevelClearAnimation();
-    void checkHighScore();
     void updateHighScoreBlink(float dt);
     void renderHUD();
     void renderFruitDisplay();
+    void drawCenteredText(const Sprite* sprite);
     
     // High score persistence
     std::string getHighScorePath() const;
@@ -174,13 +181,9 @@ private:
     void saveHighScore();
     void resetHighScore();
     
-    // Helpers
-    std::string getGhostPointsTexture(int ghostIndex) const;
-    std::string getFruitTextureForLevel(int lvl) const;
-    
     // Control de volumen
     void handleVolumeClick(int mouseX, int mouseY);
     void cycleVolume();
     void renderVolumeIcon();
-    std::string getVolumeTextureKey() const;
+    const Sprite* getVolumeSprite() const;
 };
@@ -0,0 +1,723 @@
+// GameCore.cpp
+// Lógica del juego sin dependencias de SDL
+#include "GameCore.h"
+#include "Constants.h"
+#include "Zobrist.h"
+#include "Profiler.h"
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+// Tiempos de Scatter/Chase
+static const float SCATTER_TIMES[] = {7.0f, 7.0f, 5.0f, 5.0f};
+static const float CHASE_TIMES[] = {20.0f, 20.0f, 20.0f, 999999.0f};
+
+GameCore::GameCore(uint32_t s) : seed(s), rng(s) {
+    // Un fantasma por personalidad (Blinky, Pinky, Inky, Clyde)
+    for (const GhostTraits& traits : GhostPersonalities::table) {
+        ghosts.push_back(Ghost(traits.type));
+    }
+    GhostAI::initLanes(ghostLanes, ghosts);
+    collectedFruits.reserve(MAX_COLLECTED_FRUITS);
+}
+
+void GameCore::setHighScore(int hs) {
+    highScore = hs;
+    previousHighScore = hs;
+}
+
+void GameCore::resetHighScore() {
+    highScore = 0;
+    previousHighScore = 0;
+    highScoreBeaten = false;
+}
+
+FruitInfo GameCore::getFruitInfo(int lvl) {
+    FruitInfo info;
+    
+    switch (lvl) {
+        case 1:
+            info.type = FruitType::Cherry;
+            info.points = 100;
+            break;
+        case 2:
+            info.type = FruitType::Strawberry;
+            info.points = 300;
+            break;
+        case 3:
+        case 4:
+            info.type = FruitType::Orange;
+            info.points = 500;
+            break;
+        case 5:
+        case 6:
+            info.type = FruitType::Apple;
+            info.points = 700;
+            break;
+        case 7:
+        case 8:
+            info.type = FruitType::Melon;
+            info.points = 1000;
+            break;
+        case 9:
+        case 10:
+            info.type = FruitType::Ship;
+            info.points = 2000;
+            break;
+        case 11:
+        case 12:
+            info.type = FruitType::Bell;
+            info.points = 3000;
+            break;
+        default:  // Nivel 13+
+            info.type = FruitType::Key;
+            info.points = 5000;
+            break;
+    }
+    
+    return info;
+}
+
+int GameCore::getSpeedPercent() const {
+    // +5% por nivel, hasta +30%
+    return 100 + std::min(level - 1, 6) * 5;
+}
+
+void GameCore::emit(GameEventType type, int value, int tileX, int tileY) {
+    GameEvent e;
+    e.type = type;
+    e.tileX = static_cast<int8_t>(tileX);
+    e.tileY = static_cast<int8_t>(tileY);
+    e.value = value;
+    e.tick = tick;
+    events.push(e);
+}
+
+// ===== SNAPSHOTS =====
+
+void GameCore::save(GameSnapshot& out) const {
+    out.tick = tick;
+    out.seed = seed;
+    out.rngState = rng.getState();
+    
+    out.state = static_cast<int32_t>(state);
+    out.stateBeforePause = static_cast<int32_t>(stateBeforePause);
+    
+    out.stateTimer = stateTimer;
+    out.frightenedTimer = frightenedTimer;
+    out.scatterChaseTimer = scatterChaseTimer;
+    out.fruitTimer = fruitTimer;
+    out.freezeTimer = freezeTimer;
+    out.levelClearTimer = levelClearTimer;
+    out.levelClearBlinkTimer = levelClearBlinkTimer;
+    out.fruitRespawnTimer = fruitRespawnTimer;
+    
+    out.score = score;
+    out.highScore = highScore;
+    out.previousHighScore = previousHighScore;
+    out.lives = lives;
+    out.level = level;
+    out.dotsEaten = dotsEaten;
+    out.ghostsEatenInFright = ghostsEatenInFright;
+    out.scatterChasePhase = scatterChasePhase;
+    out.ghostsInEyes = ghostsInEyes;
+    
+    out.levelClearBlinkState = levelClearBlinkState;
+    out.highScoreBeaten = highScoreBeaten;
+    out.inScatterMode = inScatterMode;
+    out.fruitVisible = fruitVisible;
+    out.fruitEaten = fruitEaten;
+    out.sirenFast = sirenFast;
+    
+    out.collectedFruitCount = static_cast<uint8_t>(collectedFruits.size());
+    for (size_t i = 0; i < collectedFruits.size(); i++) {
+        out.collectedFruits[i] = static_cast<uint8_t>(collectedFruits[i]);
+    }
+    
+    const MapLayers& layers = map.getLayers();
+    for (int y = 0; y < MAP_HEIGHT; y++) {
+        out.dots[y] = layers.dots[y];
+        out.pellets[y] = layers.pellets[y];
+    }
+    out.remainingDots = map.getRemainingDots();
+    out.dotHash = map.getDotHash();
+    
+    out.pacman = pacman;
+    for (int i = 0; i < GhostPersonalities::count; i++) {
+        out.ghosts[i] = ghosts[i];
+    }
+}
+
+void GameCore::restore(const GameSnapshot& in) {
+    tick = in.tick;
+    seed = in.seed;
+    rng.setState(in.rngState);
+    
+    state = static_cast<GameState>(in.state);
+    stateBeforePause = static_cast<GameState>(in.stateBeforePause);
+    
+    stateTimer = in.stateTimer;
+    frightenedTimer = in.frightenedTimer;
+    scatterChaseTimer = in.scatterChaseTimer;
+    fruitTimer = in.fruitTimer;
+    freezeTimer = in.freezeTimer;
+    levelClearTimer = in.levelClearTimer;
+    levelClearBlinkTimer = in.levelClearBlinkTimer;
+    fruitRespawnTimer = in.fruitRespawnTimer;
+    
+    score = in.score;
+    highScore = in.highScore;
+    previousHighScore = in.previousHighScore;
+    lives = in.lives;
+    level = in.level;
+    dotsEaten = in.dotsEaten;
+    ghostsEatenInFright = in.ghostsEatenInFright;
+    scatterChasePhase = in.scatterChasePhase;
+    ghostsInEyes = in.ghostsInEyes;
+    
+    levelClearBlinkState = in.levelClearBlinkState;
+    highScoreBeaten = in.highScoreBeaten;
+    inScatterMode = in.inScatterMode;
+    fruitVisible = in.fruitVisible;
+    fruitEaten = in.fruitEaten;
+    sirenFast = in.sirenFast;
+    
+    // Con capacidad para 7 frutas no vuelve a asignar memoria
+    collectedFruits.clear();
+    for (int i = 0; i < in.collectedFruitCount; i++) {
+        collectedFruits.push_back(static_cast<FruitType>(in.collectedFruits[i]));
+    }
+    
+    map.setDotLayers(in.dots, in.pellets, in.remainingDots, in.dotHash);
+    
+    pacman = in.pacman;
+    for (int i = 0; i < GhostPersonalities::count; i++) {
+        ghosts[i] = in.ghosts[i];
+    }
+}
+
+// ===== HASH =====
+
+// Entidad en un tile con dirección y modo (Pac-Man es la entidad 0 y en
+// lugar del modo lleva la dirección deseada)
+static uint64_t entityKey(int entity, int tileX, int tileY, Direction dir, int mode) {
+    uint64_t feature = (static_cast<uint64_t>(entity) << 24) |
+                       (static_cast<uint64_t>(mode) << 20) |
+                       (static_cast<uint64_t>(dir) << 16) |
+                       (static_cast<uint64_t>(tileY & 0xFF) << 8) |
+                       static_cast<uint64_t>(tileX & 0xFF);
+    return zobristKey(ZobristDomain::Entity, feature);
+}
+
+// Valor escalar (puntaje, timer...): el campo va en los bits altos
+static uint64_t scalarKey(int field, uint32_t value) {
+    return zobristKey(ZobristDomain::Scalar, (static_cast<uint64_t>(field) << 32) | value);
+}
+
+static uint32_t floatBits(float f) {
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+// Campos escalares por entidad (4 por entidad, después de los globales)
+static constexpr int ENTITY_FIELDS = 32;
+
+// Posición en punto fijo: distingue el avance dentro del tile
+static uint64_t positionKey(int entity, const Vector2i& position) {
+    return scalarKey(ENTITY_FIELDS + entity * 4, static_cast<uint32_t>(position.x)) ^
+           scalarKey(ENTITY_FIELDS + entity * 4 + 1, static_cast<uint32_t>(position.y));
+}
+
+uint64_t GameCore::getHash() const {
+    // Los dots se mantienen incrementalmente en el mapa. Entidades y
+    // escalares se recalculan en cada llamada (unas 40 claves, sin memoria)
+    uint64_t hash = map.getDotHash();
+    
+    hash ^= entityKey(0, pacman.getTileX(), pacman.getTileY(), pacman.direction,
+                      static_cast<int>(pacman.getDesiredDirection()));
+    hash ^= positionKey(0, pacman.getPosition());
+    for (size_t i = 0; i < ghosts.size(); i++) {
+        const Ghost& g = ghosts[i];
+        int entity = static_cast<int>(i) + 1;
+        hash ^= entityKey(entity, g.getTileX(), g.getTileY(), g.direction,
+                          static_cast<int>(g.getMode()));
+        hash ^= positionKey(entity, g.getPosition());
+        
+        // Casa: dos fantasmas en el mismo tile pueden estar en fases distintas
+        uint32_t houseFlags = (g.isInHouse() ? 1u : 0u) | (g.isExitingHouse() ? 2u : 0u) |
+                              (g.isEnteringHouse() ? 4u : 0u) |
+                              (static_cast<uint32_t>(g.getExitPhase()) << 3);
+        hash ^= scalarKey(ENTITY_FIELDS + entity * 4 + 2, houseFlags);
+        hash ^= scalarKey(ENTITY_FIELDS + entity * 4 + 3, floatBits(g.getHouseTimer()));
+    }
+    
+    hash ^= scalarKey(0, static_cast<uint32_t>(state));
+    hash ^= scalarKey(1, static_cast<uint32_t>(score));
+    hash ^= scalarKey(2, static_cast<uint32_t>(lives));
+    hash ^= scalarKey(3, static_cast<uint32_t>(level));
+    hash ^= scalarKey(4, rng.getState());
+    hash ^= scalarKey(5, floatBits(stateTimer));
+    hash ^= scalarKey(6, floatBits(frightenedTimer));
+    hash ^= scalarKey(7, floatBits(scatterChaseTimer));
+    hash ^= scalarKey(8, floatBits(fruitTimer));
+    
+    // Todo lo que cambia lo que pasa después, aunque todavía no se vea en las posiciones
+    uint32_t flags = (fruitVisible ? 1u : 0u) | (fruitEaten ? 2u : 0u) |
+                     (inScatterMode ? 4u : 0u) | (levelClearBlinkState ? 8u : 0u);
+    hash ^= scalarKey(9, flags);
+    hash ^= scalarKey(10, static_cast<uint32_t>(scatterChasePhase));
+    hash ^= scalarKey(11, static_cast<uint32_t>(ghostsEatenInFright));
+    hash ^= scalarKey(12, floatBits(freezeTimer));
+    hash ^= scalarKey(13, floatBits(levelClearTimer));
+    hash ^= scalarKey(14, floatBits(levelClearBlinkTimer));
+    hash ^= scalarKey(15, floatBits(fruitRespawnTimer));
+    hash ^= scalarKey(16, static_cast<uint32_t>(dotsEaten));
+    hash ^= scalarKey(17, static_cast<uint32_t>(stateBeforePause));
+    
+    return hash;
+}
+
+// ===== CONTROL =====
+
+bool GameCore::startGame() {
+    if (state != GameState::PressStart)
+        return false;
+    
+    state = GameState::Startup;
+    stateTimer = 0.0f;
+    return true;
+}
+
+void GameCore::newGame() {
+    previousHighScore = highScore;
+    highScoreBeaten = false;
+    score = 0;
+    lives = 3;
+    level = 1;
+    collectedFruits.clear();
+    map.resetLevel();
+    startLevel();
+}
+
+bool GameCore::pause() {
+    if (state != GameState::Playing)
+        return false;
+    
+    stateBeforePause = state;
+    state = GameState::Paused;
+    return true;
+}
+
+bool GameCore::resume() {
+    if (state != GameState::Paused)
+        return false;
+    
+    state = stateBeforePause;
+    return true;
+}
+
+bool GameCore::setDesiredDirection(Direction dir) {
+    if (state != GameState::Playing || pacman.getDesiredDirection() == dir)
+        return false;
+    
+    pacman.setDesiredDirection(dir);
+    return true;
+}
+
+void GameCore::startLevel() {
+    resetPositions();
+    dotsEaten = 0;
+    fruitVisible = false;
+    fruitEaten = false;
+    fruitRespawnTimer = 0.0f;
+    frightenedTimer = 0.0f;
+    ghostsEatenInFright = 0;
+    
+    inScatterMode = true;
+    scatterChasePhase = 0;
+    scatterChaseTimer = SCATTER_TIMES[0];
+    
+    state = GameState::Ready;
+    stateTimer = READY_TIME;
+    
+    emit(GameEventType::LevelStarted);
+}
+
+void GameCore::resetPositions() {
+    pacman.reset();
+    pacman.setSpeedPercent(getSpeedPercent());
+    
+    for (auto& ghost : ghosts) {
+        ghost.reset();
+        ghost.setSpeedPercent(getSpeedPercent());
+    }
+    
+    ghostsInEyes = 0;
+    
+    // Como en el arcade, el generador se reinicia en cada nivel y cada vida
+    rng.setState(seed);
+}
+
+// ===== UPDATE =====
+
+void GameCore::update() {
+    // El movimiento es de paso fijo; los temporizadores también usan SIM_DT
+    const float dt = SIM_DT;
+    tick++;
+    
+    switch (state) {
+        case GameState::PressStart:
+            break;
+        
+        case GameState::Startup:
+            // Duración de la melodía de inicio (antes se consultaba al mixer)
+            stateTimer += dt;
+            if (stateTimer >= STARTUP_TIME) {
+                startLevel();
+            }
+            break;
+        
+        case GameState::Ready:
+            stateTimer -= dt;
+            if (stateTimer <= 0.0f) {
+                state = GameState::Playing;
+                emit(GameEventType::PlayingStarted);
+            }
+            break;
+        
+        case GameState::Playing:
+            updatePlaying(dt);
+            break;
+        
+        case GameState::Paused:
+            break;
+        
+        case GameState::GhostEaten:
+            freezeTimer -= dt;
+            if (freezeTimer <= 0.0f) {
+                state = GameState::Playing;
+                emit(GameEventType::GhostEatenFreezeEnded);
+            }
+            break;
+        
+        case GameState::PreDeath:
+            freezeTimer -= dt;
+            if (freezeTimer <= 0.0f) {
+                state = GameState::Death;
+                pacman.die();
+                emit(GameEventType::DeathAnimationStarted);
+            }
+            break;
+        
+        case GameState::Death:
+            pacman.updateDeathAnimation(dt);
+            if (pacman.isDeathAnimationComplete()) {
+                lives--;
+                if (lives <= 0) {
+                    state = GameState::GameOver;
+                    emit(GameEventType::GameOver);
+                }
+                else {
+                    resetPositions();
+                    state = GameState::Ready;
+                    stateTimer = READY_TIME;
+                }
+            }
+            break;
+        
+        case GameState::LevelClear:
+            updateLevelClearAnimation(dt);
+            break;
+        
+        case GameState::GameOver:
+            break;
+    }
+}
+
+void GameCore::updateLevelClearAnimation(float dt) {
+    levelClearTimer += dt;
+    levelClearBlinkTimer += dt;
+    
+    if (levelClearBlinkTimer >= LEVEL_CLEAR_BLINK_SPEED) {
+        levelClearBlinkTimer = 0.0f;
+        levelClearBlinkState = !levelClearBlinkState;
+    }
+    
+    if (levelClearTimer >= LEVEL_CLEAR_DURATION) {
+        level++;
+        
+        if (collectedFruits.size() >= MAX_COLLECTED_FRUITS) {
+            collectedFruits.erase(collectedFruits.begin());
+        }
+        FruitInfo fruitInfo = getCurrentFruitInfo();
+        collectedFruits.push_back(fruitInfo.type);
+        
+        map.resetLevel();
+        startLevel();
+    }
+}
+
+// Pac-Man come lo que haya en su tile al llegar al centro (antes de moverse,
+// así ese tick ya avanza a la velocidad de comer)
+void GameCore::eatAtPacman() {
+    if (!pacman.isAlive() || !pacman.isCentered()) {
+        pacman.setEating(false);
+        return;
+    }
+    
+    int tx = pacman.getTileX();
+    int ty = pacman.getTileY();
+    
+    if (map.eatDot(tx, ty)) {
+        pacman.setEating(true);
+        score += SCORE_DOT;
+        dotsEaten++;
+        emit(GameEventType::DotEaten, 0, tx, ty);
+        checkHighScore();
+        spawnFruit();
+    }
+    else if (map.eatPowerPellet(tx, ty)) {
+        pacman.setEating(true);
+        score += SCORE_POWER_PELLET;
+        dotsEaten++;
+        emit(GameEventType::PelletEaten, 0, tx, ty);
+        checkHighScore();
+        activateFrightenedMode();
+        spawnFruit();
+    }
+    else {
+        pacman.setEating(false);
+    }
+}
+
+void GameCore::updatePlaying(float dt) {
+    PROFILE_ZONE("GameCore::updatePlaying");
+    updateScatterChaseMode(dt);
+    
+    eatAtPacman();
+    pacman.update(dt, map);
+    
+    if (frightenedTimer > 0.0f) {
+        frightenedTimer -= dt;
+        
+        bool shouldBlink = frightenedTimer <= FRIGHTENED_BLINK_TIME;
+        for (auto& ghost : ghosts) {
+            if (ghost.getMode() == GhostMode::Frightened) {
+                ghost.setBlinking(shouldBlink);
+            }
+        }
+        
+        if (frightenedTimer <= 0.0f) {
+            for (auto& ghost : ghosts) {
+                if (ghost.getMode() == GhostMode::Frightened) {
+                    ghost.setMode(inScatterMode ? GhostMode::Scatter : GhostMode::Chase);
+                    ghost.setBlinking(false);
+                }
+            }
+            ghostsEatenInFright = 0;
+            emit(GameEventType::ModeChanged, static_cast<int>(inScatterMode ? GhostMode::Scatter : GhostMode::Chase));
+        }
+    }
+    
+    // Objetivos de todos los fantasmas en una pasada, luego mover
+    GhostAI::gatherLanes(ghostLanes, ghosts);
+    GhostAI::computeTargets(ghostLanes, pacman);
+    
+    for (int i = 0; i < ghostLanes.count; i++) {
+        bool wasEyes = ghosts[i].getMode() == GhostMode::Eyes;
+        
+        ghosts[i].setTarget(Vector2i(ghostLanes.targetX[i], ghostLanes.targetY[i]));
+        if (ghosts[i].getMode() == GhostMode::Frightened) {
+            ghosts[i].setRandomBits(rng.next());
+        }
+        ghosts[i].update(dt, map);
+        
+        // Regenerado en la casa
+        if (wasEyes && ghosts[i].getMode() != GhostMode::Eyes && --ghostsInEyes == 0) {
+            emit(GameEventType::EyesReturning, 0);
+        }
+    }
+    
+    checkCollisions();
+    updateSiren();
+    checkLevelComplete();
+    
+    if (fruitVisible) {
+        fruitTimer -= dt;
+        if (fruitTimer <= 0.0f) {
+            fruitVisible = false;
+        }
+    }
+    
+    if (fruitEaten && !fruitVisible) {
+        fruitRespawnTimer += dt;
+        if (fruitRespawnTimer >= FRUIT_RESPAWN_TIME) {
+            fruitVisible = true;
+            fruitTimer = FRUIT_VISIBLE_TIME;
+            fruitRespawnTimer = 0.0f;
+            fruitEaten = false;
+        }
+    }
+}
+
+void GameCore::checkHighScore() {
+    if (previousHighScore > 0 && !highScoreBeaten && score > previousHighScore) {
+        highScoreBeaten = true;
+        emit(GameEventType::HighScoreBeaten);
+    }
+    
+    if (score > highScore) {
+        highScore = score;
+    }
+}
+
+void GameCore::updateScatterChaseMode(float dt) {
+    if (frightenedTimer > 0.0f)
+        return;
+    
+    scatterChaseTimer -= dt;
+    
+    if (scatterChaseTimer <= 0.0f) {
+        inScatterMode = !inScatterMode;
+        
+        if (!inScatterMode) {
+            scatterChaseTimer = CHASE_TIMES[scatterChasePhase];
+        }
+        else {
+            scatterChasePhase++;
+            if (scatterChasePhase >= 4) scatterChasePhase = 3;
+            scatterChaseTimer = SCATTER_TIMES[scatterChasePhase];
+        }
+        
+        GhostMode newMode = inScatterMode ? GhostMode::Scatter : GhostMode::Chase;
+        for (auto& ghost : ghosts) {
+            if (ghost.getMode() != GhostMode::Frightened &&
+                ghost.getMode() != GhostMode::Eyes) {
+                ghost.setMode(newMode);
+            }
+        }
+        
+        emit(GameEventType::ModeChanged, static_cast<int>(newMode));
+    }
+}
+
+void GameCore::activateFrightenedMode() {
+    frightenedTimer = FRIGHTENED_TIME;
+    ghostsEatenInFright = 0;
+    
+    for (auto& ghost : ghosts) {
+        if (ghost.getMode() != GhostMode::Eyes) {
+            ghost.setMode(GhostMode::Frightened);
+        }
+    }
+    
+    emit(GameEventType::ModeChanged, static_cast<int>(GhostMode::Frightened));
+}
+
+void GameCore::checkCollisions() {
+    PROFILE_ZONE("GameCore::checkCollisions");
+    int pacTileX = pacman.getTileX();
+    int pacTileY = pacman.getTileY();
+    
+    for (auto& ghost : ghosts) {
+        int ghostTileX = ghost.getTileX();
+        int ghostTileY = ghost.getTileY();
+        
+        if (pacTileX == ghostTileX && pacTileY == ghostTileY) {
+            if (ghost.getMode() == GhostMode::Frightened) {
+                eatGhost(ghost);
+                return;
+            }
+            else if (ghost.getMode() != GhostMode::Eyes) {
+                pacmanDied();
+                return;
+            }
+        }
+    }
+    
+    if (fruitVisible) {
+        // Todo en punto fijo; se compara la distancia al cuadrado
+        int fruitX = tileToFixed(FRUIT_TILE_X) + FIXED_TILE / 2;
+        int fruitY = tileToFixed(FRUIT_TILE_Y);
+        
+        int pacCenterX = pacman.getPosition().x + FIXED_TILE / 2;
+        int pacCenterY = pacman.getPosition().y + FIXED_TILE / 2;
+        
+        int64_t dx = pacCenterX - fruitX;
+        int64_t dy = pacCenterY - fruitY;
+        int64_t radius = FIXED_TILE * 3 / 5;  // 0.6 tiles
+        
+        if (dx * dx + dy * dy < radius * radius) {
+            FruitInfo fruitInfo = getCurrentFruitInfo();
+            score += fruitInfo.points;
+            checkHighScore();
+            
+            emit(GameEventType::FruitEaten, static_cast<int>(fruitInfo.type), pacTileX, pacTileY);
+            
+            fruitVisible = false;
+            fruitEaten = true;
+            fruitRespawnTimer = 0.0f;
+        }
+    }
+}
+
+void GameCore::eatGhost(Ghost& ghost) {
+    int points;
+    
+    switch (ghostsEatenInFright) {
+        case 0:  points = SCORE_GHOST_1; break;
+        case 1:  points = SCORE_GHOST_2; break;
+        case 2:  points = SCORE_GHOST_3; break;
+        default: points = SCORE_GHOST_4; break;
+    }
+    
+    score += points;
+    checkHighScore();
+    
+    emit(GameEventType::GhostEaten, ghostsEatenInFright, ghost.getTileX(), ghost.getTileY());
+    ghostsEatenInFright++;
+    
+    ghost.sendToHouse();
+    if (ghostsInEyes++ == 0) {
+        emit(GameEventType::EyesReturning, 1);
+    }
+    
+    state = GameState::GhostEaten;
+    freezeTimer = FREEZE_TIME;
+}
+
+void GameCore::pacmanDied() {
+    state = GameState::PreDeath;
+    freezeTimer = FREEZE_TIME;
+    
+    emit(GameEventType::Death, 0, pacman.getTileX(), pacman.getTileY());
+}
+
+void GameCore::checkLevelComplete() {
+    if (map.getRemainingDots() <= 0) {
+        state = GameState::LevelClear;
+        levelClearTimer = 0.0f;
+        levelClearBlinkTimer = 0.0f;
+        levelClearBlinkState = false;
+        
+        emit(GameEventType::LevelClear);
+    }
+}
+
+void GameCore::spawnFruit() {
+    if ((dotsEaten == 70 || dotsEaten == 170) && !fruitVisible && !fruitEaten) {
+        fruitVisible = true;
+        fruitTimer = FRUIT_VISIBLE_TIME;
+    }
+}
+
+void GameCore::updateSiren() {
+    int remaining = map.getRemainingDots();
+    bool shouldBeFast = remaining < 30;
+    
+    if (shouldBeFast != sirenFast && frightenedTimer <= 0.0f) {
+        sirenFast = shouldBeFast;
+        emit(GameEventType::SirenChanged, sirenFast ? 1 : 0);
+    }
+}
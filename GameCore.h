@@ -0,0 +1,189 @@
+// GameCore.h
+// Núcleo de simulación de Pac-Man (sin SDL: ni ventana, ni audio, ni texturas)
+// Lo usan el front end SDL (Game) y el modo --headless de Main.cpp.
+// Los efectos secundarios (audio, puntajes flotantes, persistencia) se
+// comunican con eventos: el front end vacía la cola después de cada update.
+#pragma once
+
+#include "Pacman.h"
+#include "Ghost.h"
+#include "Map.h"
+#include "GhostAI.h"
+#include "GameEvents.h"
+#include "GameRandom.h"
+#include "GameSnapshot.h"
+#include <vector>
+#include <string>
+
+// Estados del juego
+enum class GameState {
+    PressStart,   // Esperando Enter para comenzar
+    Startup,      // Reproduciendo música de inicio
+    Ready,        // Mostrando "READY!"
+    Playing,      // Jugando
+    Paused,       // Juego pausado
+    GhostEaten,   // Congelado después de comer fantasma (0.5 segundos)
+    PreDeath,     // Pausa antes de animación de muerte (0.5 segundos)
+    Death,        // Animación de muerte
+    GameOver,     // Game Over
+    LevelClear    // Nivel completado (parpadeo del mapa)
+};
+
+// Tipos de fruta (8 frutas total)
+enum class FruitType {
+    Cherry,      // Nivel 1 - 100 pts
+    Strawberry,  // Nivel 2 - 300 pts
+    Orange,      // Nivel 3-4 - 500 pts
+    Apple,       // Nivel 5-6 - 700 pts
+    Melon,       // Nivel 7-8 - 1000 pts
+    Ship,        // Nivel 9-10 - 2000 pts (Galaxian)
+    Bell,        // Nivel 11-12 - 3000 pts
+    Key          // Nivel 13+ - 5000 pts
+};
+
+// Información de fruta
+struct FruitInfo {
+    FruitType type;  // El front end elige los sprites de la fruta y del puntaje
+    int points;
+};
+
+class GameCore {
+public:
+    explicit GameCore(uint32_t s = GameRandom::DEFAULT_SEED);
+    
+    // Avanza un tick fijo de SIM_DT
+    void update();
+    
+    // Eventos pendientes (un solo consumidor)
+    GameEventQueue& getEvents() { return events; }
+    uint32_t getTick() const { return tick; }
+    
+    // Semilla del generador de decisiones en Frightened (misma semilla y
+    // mismas entradas -> misma partida)
+    void setSeed(uint32_t s) { seed = s; rng.setState(s); }
+    uint32_t getSeed() const { return seed; }
+    
+    // Nivel inicial (solo antes de empezar, p. ej. al reproducir un replay)
+    void setStartLevel(int l) { if (state == GameState::PressStart && l >= 1) level = l; }
+    
+    // Snapshots del estado completo (sin asignar memoria; la cola de
+    // eventos no se toca)
+    void save(GameSnapshot& out) const;
+    void restore(const GameSnapshot& in);
+    
+    // Hash de Zobrist del estado (sin tick ni semilla): detecta desyncs entre
+    // dos ejecuciones y sirve de clave para tablas de transposición
+    uint64_t getHash() const;
+    
+    // Control
+    bool startGame();   // PressStart -> Startup (true si arrancó)
+    void newGame();     // Reiniciar después de Game Over
+    bool pause();       // true si efectivamente se pausó
+    bool resume();      // true si efectivamente se reanudó
+    bool setDesiredDirection(Direction dir);  // true si cambió la dirección deseada
+    
+    // Estado
+    GameState getState() const { return state; }
+    int getScore() const { return score; }
+    int getHighScore() const { return highScore; }
+    int getLives() const { return lives; }
+    int getLevel() const { return level; }
+    bool isFrightened() const { return frightenedTimer > 0.0f; }
+    bool isSirenFast() const { return sirenFast; }
+    bool isFruitVisible() const { return fruitVisible; }
+    bool isLevelClearFlashOn() const { return levelClearBlinkState; }
+    bool anyGhostEyes() const { return ghostsInEyes > 0; }
+    
+    const Map& getMap() const { return map; }
+    const PacMan& getPacman() const { return pacman; }
+    const std::vector<Ghost>& getGhosts() const { return ghosts; }
+    const std::vector<FruitType>& getCollectedFruits() const { return collectedFruits; }
+    FruitInfo getCurrentFruitInfo() const { return getFruitInfo(level); }
+    static FruitInfo getFruitInfo(int lvl);  // Fruta del nivel lvl
+    
+    // High score (la persistencia la hace el front end)
+    void setHighScore(int hs);
+    void resetHighScore();
+
+private:
+    // Acceso de Bench.cpp a métodos privados (solo microbenchmarks)
+    friend struct BenchAccess;
+    
+    GameEventQueue events;
+    uint32_t tick = 0;
+    
+    uint32_t seed;
+    GameRandom rng;
+    
+    GameState state = GameState::PressStart;
+    GameState stateBeforePause = GameState::Playing;
+    
+    // Timers
+    float stateTimer = 0.0f;
+    float frightenedTimer = 0.0f;
+    float scatterChaseTimer = 0.0f;
+    float fruitTimer = 0.0f;
+    
+    // Freeze timers (para comer fantasma y pre-muerte)
+    float freezeTimer = 0.0f;
+    static constexpr float FREEZE_TIME = 0.5f;
+    
+    // Level Clear animation
+    float levelClearTimer = 0.0f;
+    float levelClearBlinkTimer = 0.0f;
+    bool levelClearBlinkState = false;
+    static constexpr float LEVEL_CLEAR_DURATION = 3.0f;
+    static constexpr float LEVEL_CLEAR_BLINK_SPEED = 0.15f;
+    
+    // Puntuación
+    int score = 0;
+    int highScore = 0;
+    int previousHighScore = 0;
+    bool highScoreBeaten = false;
+    
+    int lives = 3;
+    int level = 1;
+    int dotsEaten = 0;
+    int ghostsEatenInFright = 0;
+    
+    // Modo scatter/chase
+    bool inScatterMode = true;
+    int scatterChasePhase = 0;
+    
+    // Fruta
+    bool fruitVisible = false;
+    bool fruitEaten = false;
+    float fruitRespawnTimer = 0.0f;
+    static constexpr float FRUIT_RESPAWN_TIME = 35.0f;
+    std::vector<FruitType> collectedFruits;
+    
+    // Sirena y ojos (solo se notifican los cambios)
+    bool sirenFast = false;
+    int ghostsInEyes = 0;  // Se actualiza al comer fantasmas y al regenerarse
+    
+    // Laberinto de esta partida
+    Map map;
+    
+    // Entidades
+    PacMan pacman;
+    std::vector<Ghost> ghosts;
+    GhostLanes ghostLanes;  // IA de los fantasmas en arrays paralelos
+    
+    // Métodos
+    void startLevel();
+    void resetPositions();
+    void updatePlaying(float dt);
+    void eatAtPacman();
+    void checkCollisions();
+    void activateFrightenedMode();
+    void updateScatterChaseMode(float dt);
+    void updateSiren();
+    void eatGhost(Ghost& ghost);
+    void pacmanDied();
+    void checkLevelComplete();
+    void spawnFruit();
+    void checkHighScore();
+    void updateLevelClearAnimation(float dt);
+    int getSpeedPercent() const;
+    void emit(GameEventType type, int value = 0, int tileX = -1, int tileY = -1);
+};
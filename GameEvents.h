@@ -0,0 +1,108 @@
+// GameEvents.h
+// Eventos de la simulación en una cola circular de capacidad fija
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+enum class GameEventType : uint8_t {
+    LevelStarted,
+    PlayingStarted,        // READY! -> Playing
+    DotEaten,
+    PelletEaten,
+    FruitEaten,            // value = FruitType
+    GhostEaten,            // value = índice del combo (0-3)
+    GhostEatenFreezeEnded,
+    ModeChanged,           // value = GhostMode (Frightened al comer pellet, Scatter/Chase al volver)
+    EyesReturning,         // value = 1 si hay ojos volviendo, 0 si ya no
+    SirenChanged,          // value = 1 si es la sirena rápida
+    HighScoreBeaten,
+    Death,                 // Pac-Man atrapado (inicio de PreDeath)
+    DeathAnimationStarted,
+    LevelClear,
+    GameOver
+};
+
+// 12 bytes, trivialmente copiable
+struct GameEvent {
+    GameEventType type;
+    int8_t tileX;     // Tile donde ocurrió (-1 si no aplica)
+    int8_t tileY;
+    int32_t value;    // Dato según el tipo
+    uint32_t tick;    // Tick de simulación
+};
+
+// Cola circular sin reservas de memoria. Un productor (la simulación) y un
+// consumidor, que puede estar en otro hilo. Si se llena (nadie consume,
+// p. ej. en modo headless) los eventos nuevos se descartan y se cuentan.
+template <typename T, uint32_t Capacity>
+class EventRing {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity debe ser potencia de 2");
+
+public:
+    EventRing() = default;
+    
+    // Copiar la cola copia su contenido (para clonar una partida)
+    EventRing(const EventRing& other) { copyFrom(other); }
+    EventRing& operator=(const EventRing& other) {
+        if (this != &other) copyFrom(other);
+        return *this;
+    }
+    
+    // Productor
+    bool push(const T& item) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == Capacity) {
+            dropped++;
+            return false;
+        }
+        items[h & (Capacity - 1)] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+    
+    // Consumidor: procesa todo lo pendiente en una pasada, fn(const T&).
+    // Sin eventos solo compara dos índices.
+    template <typename Fn>
+    uint32_t drain(Fn&& fn) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        uint32_t h = head.load(std::memory_order_acquire);
+        for (uint32_t i = t; i != h; i++) {
+            fn(items[i & (Capacity - 1)]);
+        }
+        tail.store(h, std::memory_order_release);
+        return h - t;
+    }
+    
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+    
+    // Solo cuando ni el productor ni el consumidor están activos
+    void clear() {
+        tail.store(head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        dropped = 0;
+    }
+    
+    uint32_t getDropped() const { return dropped; }
+    static constexpr uint32_t capacity() { return Capacity; }
+
+private:
+    T items[Capacity];
+    std::atomic<uint32_t> head{0};
+    std::atomic<uint32_t> tail{0};
+    uint32_t dropped = 0;  // Solo lo escribe el productor
+    
+    void copyFrom(const EventRing& other) {
+        uint32_t t = other.tail.load(std::memory_order_acquire);
+        uint32_t h = other.head.load(std::memory_order_acquire);
+        for (uint32_t i = t; i != h; i++) {
+            items[i & (Capacity - 1)] = other.items[i & (Capacity - 1)];
+        }
+        head.store(h, std::memory_order_relaxed);
+        tail.store(t, std::memory_order_relaxed);
+        dropped = other.dropped;
+    }
+};
+
+using GameEventQueue = EventRing<GameEvent, 256>;
@@ -0,0 +1,28 @@
+// GameRandom.h
+// Generador pseudoaleatorio determinista por partida
+#pragma once
+
+#include <cstdint>
+
+// xorshift32: 4 bytes de estado, sin dependencias de la plataforma.
+// Misma semilla y mismas entradas -> misma partida en cualquier máquina.
+class GameRandom {
+public:
+    static constexpr uint32_t DEFAULT_SEED = 0x2545F491u;
+    
+    explicit GameRandom(uint32_t seed = DEFAULT_SEED) { setState(seed); }
+    
+    uint32_t next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+    
+    // El estado completo (para snapshots); 0 no es válido en xorshift
+    uint32_t getState() const { return state; }
+    void setState(uint32_t s) { state = s ? s : DEFAULT_SEED; }
+
+private:
+    uint32_t state;
+};
@@ -0,0 +1,69 @@
+// GameSnapshot.h
+// Copia del estado completo de una partida (búsqueda, rewind, save states)
+#pragma once
+
+#include "Pacman.h"
+#include "Ghost.h"
+#include "GhostPersonality.h"
+#include "Constants.h"
+#include <cstdint>
+#include <type_traits>
+
+constexpr int MAX_COLLECTED_FRUITS = 7;  // Frutas que se muestran abajo a la derecha
+
+// Tamaño fijo y sin punteros: copiarla es un memcpy de menos de 1 KB.
+// La llena GameCore::save() y la aplica GameCore::restore().
+// No incluye la cola de eventos ni el estado del front end (audio,
+// puntajes flotantes), ni las paredes: no cambian durante la partida.
+struct GameSnapshot {
+    uint32_t tick;
+    uint32_t seed;
+    uint32_t rngState;
+    
+    int32_t state;              // GameState
+    int32_t stateBeforePause;
+    
+    // Timers
+    float stateTimer;
+    float frightenedTimer;
+    float scatterChaseTimer;
+    float fruitTimer;
+    float freezeTimer;
+    float levelClearTimer;
+    float levelClearBlinkTimer;
+    float fruitRespawnTimer;
+    
+    // Puntuación y progreso
+    int32_t score;
+    int32_t highScore;
+    int32_t previousHighScore;
+    int32_t lives;
+    int32_t level;
+    int32_t dotsEaten;
+    int32_t ghostsEatenInFright;
+    int32_t scatterChasePhase;
+    int32_t ghostsInEyes;
+    
+    bool levelClearBlinkState;
+    bool highScoreBeaten;
+    bool inScatterMode;
+    bool fruitVisible;
+    bool fruitEaten;
+    bool sirenFast;
+    
+    uint8_t collectedFruitCount;
+    uint8_t collectedFruits[MAX_COLLECTED_FRUITS];  // FruitType
+    
+    // Dots y pellets que quedan (bitboards, ver MapLayers)
+    uint64_t dotHash;
+    uint32_t dots[MAP_HEIGHT];
+    uint32_t pellets[MAP_HEIGHT];
+    int32_t remainingDots;
+    
+    // Entidades (no tienen punteros ni vtable: se copian tal cual)
+    PacMan pacman;
+    Ghost ghosts[GhostPersonalities::count];
+};
+
+static_assert(std::is_trivially_copyable<GameSnapshot>::value, "GameSnapshot debe copiarse con memcpy");
+static_assert(sizeof(GameSnapshot) <= 1024, "GameSnapshot debe ocupar menos de 1 KB");
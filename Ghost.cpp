@@ -3,8 +3,8 @@
 #include "Ghost.h"
 #include "Map.h"
 #include "Constants.h"
-#include "TextureManager.h"
-#include <cmath>
+#include <cstdint>
+#include <cstdlib>
 
 // Posiciones clave de la casa de fantasmas (en tiles)
 // La puerta "--" está en fila 12, columnas 13-14
@@ -13,14 +13,17 @@ static constexpr int HOUSE_DOOR_Y = 12;       // Fila de la puerta
 static constexpr int HOUSE_ABOVE_DOOR_Y = 11; // Espacio arriba de la puerta
 static constexpr int HOUSE_CENTER_Y = 14;     // Centro interior de la casa
 
+// Centro horizontal de la puerta (entre las columnas 13 y 14), en punto fijo
+static constexpr int HOUSE_DOOR_CENTER_X = HOUSE_DOOR_X * FIXED_TILE + FIXED_TILE / 2;
+
 Ghost::Ghost(GhostType t) : type(t) {
     reset();
 }
 
-void Ghost::reset() {
+void Ghost::onReset() {
     mode = GhostMode::Scatter;
     speed = GHOST_SPEED;
-    speedMultiplier = 1.0f;
+    speedPercent = 100;
     enteringHouse = false;
     exitPhase = 0;
     
@@ -30,55 +33,14 @@ void Ghost::reset() {
     blinkTimer = 0.0f;
     blinkState = false;
     houseTimer = 0.0f;
+    clearDecisionTile();
     
-    // Posiciones iniciales según tipo
-    switch (type) {
-        case GhostType::Blinky:
-            // Blinky empieza FUERA de la casa, arriba de la puerta
-            position.x = (HOUSE_DOOR_X * TILE_SIZE + TILE_SIZE / 2) * SCALE;
-            position.y = HOUSE_ABOVE_DOOR_Y * TILE_SIZE * SCALE;
-            direction = Direction::Left;
-            inHouse = false;
-            exitingHouse = false;
-            break;
-            
-        case GhostType::Pinky:
-            // Pinky en el centro de la casa
-            position.x = (HOUSE_DOOR_X * TILE_SIZE + TILE_SIZE / 2) * SCALE;
-            position.y = HOUSE_CENTER_Y * TILE_SIZE * SCALE;
-            direction = Direction::Down;
-            inHouse = true;
-            exitingHouse = false;
-            break;
-            
-        case GhostType::Inky:
-            // Inky a la izquierda en la casa
-            position.x = (11 * TILE_SIZE + TILE_SIZE / 2) * SCALE;
-            position.y = HOUSE_CENTER_Y * TILE_SIZE * SCALE;
-            direction = Direction::Up;
-            inHouse = true;
-            exitingHouse = false;
-            break;
-            
-        case GhostType::Clyde:
-            // Clyde a la derecha en la casa
-            position.x = (15 * TILE_SIZE + TILE_SIZE / 2) * SCALE;
-            position.y = HOUSE_CENTER_Y * TILE_SIZE * SCALE;
-            direction = Direction::Up;
-            inHouse = true;
-            exitingHouse = false;
-            break;
-    }
-}
-
-float Ghost::getExitDelay() const {
-    switch (type) {
-        case GhostType::Blinky: return 0.0f;
-        case GhostType::Pinky:  return 0.0f;
-        case GhostType::Inky:   return 3.0f;   // Reducido para que salga antes
-        case GhostType::Clyde:  return 6.0f;   // Reducido
-        default: return 0.0f;
-    }
+    // Posición inicial según la personalidad
+    const GhostTraits& traits = ghostTraits(type);
+    setPosition(traits.startX, traits.startY);
+    direction = traits.startDirection;
+    inHouse = traits.startsInHouse;
+    exitingHouse = false;
 }
 
 void Ghost::setMode(GhostMode m) {
@@ -108,41 +70,40 @@ void Ghost::sendToHouse() {
     mode = GhostMode::Eyes;
     speed = GHOST_EYES_SPEED;
     enteringHouse = false;
+    clearDecisionTile();  // Cambia la máscara de salidas (puede cruzar la puerta)
 }
 
-bool Ghost::canMove(Direction dir) const {
+Direction Ghost::chooseDirection(const Map& map) const {
     int tx = getTileX();
     int ty = getTileY();
     
-    switch (dir) {
-        case Direction::Up:    ty--; break;
-        case Direction::Down:  ty++; break;
-        case Direction::Left:  tx--; break;
-        case Direction::Right: tx++; break;
-        default: return false;
-    }
+    // Una sola lectura de la tabla de salidas para las 4 direcciones
+    uint8_t exits = map.getExits(tx, ty, mode == GhostMode::Eyes);
     
-    // En modo Eyes puede atravesar la puerta
-    bool canUseGhostDoor = (mode == GhostMode::Eyes);
-    return Map::get().isWalkable(tx, ty, canUseGhostDoor);
-}
-
-Direction Ghost::chooseDirection() const {
-    int tx = getTileX();
-    int ty = getTileY();
+    // Prioridad del arcade: Up, Left, Down, Right
+    static const Direction priorities[] = {Direction::Up, Direction::Left, Direction::Down, Direction::Right};
     
-    Direction best = Direction::None;
-    float bestDist = 1e9f;
+    // Frightened (como el arcade): dirección al azar; si está bloqueada
+    // o es dar la vuelta, probar las siguientes en orden de prioridad
+    if (mode == GhostMode::Frightened) {
+        int start = static_cast<int>(randomBits & 3);
+        for (int k = 0; k < 4; k++) {
+            Direction d = priorities[(start + k) & 3];
+            if (d != oppositeDirection(direction) && (exits & directionBit(d))) {
+                return d;
+            }
+        }
+    }
     
-    // Prioridad del arcade: Up, Left, Down, Right
-    Direction priorities[] = {Direction::Up, Direction::Left, Direction::Down, Direction::Right};
+    Direction best = Direction::None;
+    int64_t bestDist = INT64_MAX;
     
     for (Direction d : priorities) {
         // No puede dar vuelta en U
         if (d == oppositeDirection(direction))
             continue;
         
-        if (!canMove(d))
+        if (!(exits & directionBit(d)))
             continue;
         
         int nx = tx, ny = ty;
@@ -154,14 +115,10 @@ Direction Ghost::chooseDirection() const {
             default: break;
         }
         
-        float dx = (nx * TILE_SIZE * SCALE) - target.x;
-        float dy = (ny * TILE_SIZE * SCALE) - target.y;
-        float dist = dx * dx + dy * dy;
-        
-        // En Frightened, maximizar distancia
-        if (mode == GhostMode::Frightened) {
-            dist = -dist;
-        }
+        // Distancia al cuadrado en punto fijo (no entra en 32 bits)
+        int64_t dx = static_cast<int64_t>(tileToFixed(nx)) - target.x;
+        int64_t dy = static_cast<int64_t>(tileToFixed(ny)) - target.y;
+        int64_t dist = dx * dx + dy * dy;
         
         if (dist < bestDist) {
             bestDist = dist;
@@ -172,7 +129,7 @@ Direction Ghost::chooseDirection() const {
     // Si no hay opción válida, intentar la opuesta
     if (best == Direction::None) {
         Direction opp = oppositeDirection(direction);
-        if (canMove(opp)) {
+        if (exits & directionBit(opp)) {
             return opp;
         }
         return direction;
@@ -181,19 +138,27 @@ Direction Ghost::chooseDirection() const {
     return best;
 }
 
-void Ghost::handleTunnelWrap() {
-    float leftBound = -SCALED_TILE;
-    float rightBound = MAP_WIDTH * SCALED_TILE;
+Direction Ghost::followCorridor(uint8_t exits) const {
+    // Salidas posibles sin dar vuelta en U
+    uint8_t options = exits & EXIT_MASK & ~directionBit(oppositeDirection(direction));
     
-    if (position.x < leftBound) {
-        position.x = rightBound;
-    }
-    else if (position.x > rightBound) {
-        position.x = leftBound;
+    switch (options) {
+        case EXIT_UP:    return Direction::Up;
+        case EXIT_DOWN:  return Direction::Down;
+        case EXIT_LEFT:  return Direction::Left;
+        case EXIT_RIGHT: return Direction::Right;
+        case 0: {
+            // Callejón: dar la vuelta si se puede
+            Direction opp = oppositeDirection(direction);
+            return (exits & directionBit(opp)) ? opp : direction;
+        }
+        default:
+            // Más de una opción sin ser nodo (p. ej. dirección None): no hay corredor que seguir
+            return direction;
     }
 }
 
-void Ghost::update(float dt) {
+void Ghost::onUpdate(float dt, Map& map) {
     // Animación siempre activa
     animTimer += dt;
     if (animTimer >= GHOST_ANIM_SPEED) {
@@ -215,37 +180,37 @@ void Ghost::update(float dt) {
         houseTimer += dt;
         
         // Esperar delay para empezar a salir
-        if (!exitingHouse && houseTimer >= getExitDelay()) {
+        if (!exitingHouse && houseTimer >= ghostTraits(type).exitDelay) {
             exitingHouse = true;
             exitPhase = 0;
         }
         
         if (exitingHouse) {
-            float exitSpeed = speed * dt * 0.8f;
-            float centerX = (HOUSE_DOOR_X * TILE_SIZE + TILE_SIZE / 2) * SCALE;
-            float exitY = HOUSE_ABOVE_DOOR_Y * TILE_SIZE * SCALE;
+            int exitSpeed = speed * 4 / 5;
+            int exitY = tileToFixed(HOUSE_ABOVE_DOOR_Y);
             
             // Fase 0: Moverse al centro horizontal
             if (exitPhase == 0) {
-                float diffX = centerX - position.x;
+                int diffX = HOUSE_DOOR_CENTER_X - getPosition().x;
                 if (std::abs(diffX) > exitSpeed) {
-                    position.x += (diffX > 0) ? exitSpeed : -exitSpeed;
+                    moveBy((diffX > 0) ? Direction::Right : Direction::Left, exitSpeed);
                 } else {
-                    position.x = centerX;
+                    setPositionX(HOUSE_DOOR_CENTER_X);
                     exitPhase = 1;
                 }
             }
             // Fase 1: Subir hacia la salida
             else if (exitPhase == 1) {
-                position.y -= exitSpeed;
-                if (position.y <= exitY) {
-                    position.y = exitY;
+                moveBy(Direction::Up, exitSpeed);
+                if (getPosition().y <= exitY) {
+                    setPositionY(exitY);
                     // Salir exitoso
                     inHouse = false;
                     exitingHouse = false;
                     exitPhase = 0;
                     direction = Direction::Left;
                     houseTimer = 0.0f;
+                    clearDecisionTile();
                 }
             }
         }
@@ -254,16 +219,15 @@ void Ghost::update(float dt) {
     
     // ===== MODO EYES: Volviendo a la casa =====
     if (mode == GhostMode::Eyes) {
-        // Posiciones clave en píxeles
-        float doorCenterX = (HOUSE_DOOR_X * TILE_SIZE + TILE_SIZE / 2) * SCALE;
-        float aboveDoorY = HOUSE_ABOVE_DOOR_Y * TILE_SIZE * SCALE;
-        float insideY = HOUSE_CENTER_Y * TILE_SIZE * SCALE;
+        // Posiciones clave en punto fijo
+        int aboveDoorY = tileToFixed(HOUSE_ABOVE_DOOR_Y);
+        int insideY = tileToFixed(HOUSE_CENTER_Y);
         
         // Verificar si esta en casa
         if (enteringHouse) {
-            position.y += speed * dt * 0.8f;
-            if (position.y >= insideY) {
-                position.y = insideY;
+            moveBy(Direction::Down, speed * 4 / 5);
+            if (getPosition().y >= insideY) {
+                setPositionY(insideY);
                 // Llegó al centro, regenerarse
                 enteringHouse = false;
                 inHouse = true;
@@ -283,81 +247,57 @@ void Ghost::update(float dt) {
         // Verificar si esta arriba de la puerta
         if ((tx == HOUSE_DOOR_X || tx == HOUSE_DOOR_X + 1) && ty == HOUSE_ABOVE_DOOR_Y) {
             // Centrar horizontalmente y empezar a bajar
-            float diffX = doorCenterX - position.x;
-            if (std::abs(diffX) > speed * dt) {
-                position.x += (diffX > 0) ? speed * dt : -speed * dt;
+            int diffX = HOUSE_DOOR_CENTER_X - getPosition().x;
+            if (std::abs(diffX) > speed) {
+                moveBy((diffX > 0) ? Direction::Right : Direction::Left, speed);
             } else {
-                position.x = doorCenterX;
+                setPositionX(HOUSE_DOOR_CENTER_X);
                 enteringHouse = true;
                 direction = Direction::Down;
             }
             return;
         }
         
-        // Target: el espacio arriba de la puerta
-        target.x = doorCenterX;
+        // Target: el espacio arriba de la puerta (solo si el flow field no cubre el tile)
+        target.x = HOUSE_DOOR_CENTER_X;
         target.y = aboveDoorY;
     }
     
     // MOVIMIENTO NORMAL
-    // Solo cambiar dirección cuando está centrado en un tile
+    // Solo decidir al llegar (primer frame centrado) a un tile nuevo.
+    // En los pasillos se sigue la única salida; los objetivos solo se
+    // evalúan en los tiles marcados TILE_DECISION.
     if (isCentered()) {
-        direction = chooseDirection();
+        int tx = getTileX();
+        int ty = getTileY();
+        
+        if (tx != decisionTileX || ty != decisionTileY) {
+            decisionTileX = tx;
+            decisionTileY = ty;
+            
+            uint8_t exits = map.getExits(tx, ty, mode == GhostMode::Eyes);
+            
+            // Los ojos siguen el flow field precalculado (camino más corto a casa)
+            Direction home = (mode == GhostMode::Eyes) ? map.getHomeDirection(tx, ty) : Direction::None;
+            
+            if (home != Direction::None) {
+                direction = home;
+            } else if (exits & TILE_DECISION) {
+                direction = chooseDirection(map);
+            } else {
+                direction = followCorridor(exits);
+            }
+        }
     }
     
     // Velocidad (más lento en túneles excepto en modo Eyes)
-    float currentSpeed = speed * speedMultiplier;  // Aplicar multiplicador de nivel
-    if (mode != GhostMode::Eyes && Map::get().isTunnel(getTileX(), getTileY())) {
-        currentSpeed = GHOST_TUNNEL_SPEED * speedMultiplier;
+    int currentSpeed = speed * speedPercent / 100;  // Aplicar multiplicador de nivel
+    if (mode != GhostMode::Eyes && (map.getExits(getTileX(), getTileY(), false) & TILE_TUNNEL)) {
+        currentSpeed = GHOST_TUNNEL_SPEED * speedPercent / 100;
     }
     
     // Mover
-    switch (direction) {
-        case Direction::Up:    position.y -= currentSpeed * dt; break;
-        case Direction::Down:  position.y += currentSpeed * dt; break;
-        case Direction::Left:  position.x -= currentSpeed * dt; break;
-        case Direction::Right: position.x += currentSpeed * dt; break;
-        default: break;
-    }
+    moveBy(direction, currentSpeed);
     
     handleTunnelWrap();
 }
-
-std::string Ghost::getTextureKey() const {
-    if (mode == GhostMode::Eyes) {
-        switch (direction) {
-            case Direction::Up:    return "ghost_eyes_up";
-            case Direction::Down:  return "ghost_eyes_down";
-            case Direction::Left:  return "ghost_eyes_left";
-            case Direction::Right: return "ghost_eyes_right";
-            default:               return "ghost_eyes_left";
-        }
-    }
-    
-    if (mode == GhostMode::Frightened) {
-        if (blinking && blinkState) {
-            return (animFrame == 0) ? "ghost_afraid_1" : "ghost_afraid_0";
-        }
-        return (animFrame == 0) ? "ghost_afraid_0" : "ghost_afraid_1";
-    }
-    
-    std::string color;
-    switch (type) {
-        case GhostType::Blinky: color = "red";    break;
-        case GhostType::Pinky:  color = "pink";   break;
-        case GhostType::Inky:   color = "blue";   break;
-        case GhostType::Clyde:  color = "orange"; break;
-    }
-    
-    return "ghost_" + color + "_" + std::to_string(animFrame);
-}
-
-void Ghost::render(SDL_Renderer* /*renderer*/) {
-    TextureManager::get().draw(
-        getTextureKey(),
-        static_cast<int>(position.x),
-        static_cast<int>(position.y) + GAME_OFFSET_Y,
-        SCALED_TILE,
-        SCALED_TILE
-    );
-}
\ No newline at end of file
@@ -6,17 +6,11 @@
 #include "Math.h"
 #include "Constants.h"
 #include "Direction.h"
+#include "GhostPersonality.h"
 
-#include <SDL2/SDL.h>
+#include <cstdint>
 #include <string>
 
-enum class GhostType {
-    Blinky,  // Rojo
-    Pinky,   // Rosa
-    Inky,    // Cyan
-    Clyde    // Naranja
-};
-
 enum class GhostMode {
     Scatter,     // Ir a esquina asignada
     Chase,       // Perseguir a Pac-Man
@@ -24,12 +18,10 @@ enum class GhostMode {
     Eyes         // Volviendo a casa
 };
 
-class Ghost : public Entity {
+class Ghost : public Entity<Ghost> {
 public:
     Ghost(GhostType type);
-    
-    void update(float dt) override;
-    void reset() override;
+    Ghost() : Ghost(GhostType::Blinky) {}  // Solo para arrays (ver GameSnapshot)
     
     // Getters
     GhostType getType() const { return type; }
@@ -37,8 +29,9 @@ public:
     
     // Setters
     void setMode(GhostMode m);
-    void setTarget(const Vector2& t) { target = t; }
-    void setSpeedMultiplier(float mult) { speedMultiplier = mult; }
+    void setTarget(const Vector2i& t) { target = t; }  // En punto fijo
+    void setRandomBits(uint32_t bits) { randomBits = bits; }  // Decisiones en Frightened
+    void setSpeedPercent(int percent) { speedPercent = percent; }  // Multiplicador de nivel (100 = base)
     
     // Control
     void reverseDirection();
@@ -46,21 +39,24 @@ public:
     
     // Estado
     bool isInHouse() const { return inHouse; }
+    bool isExitingHouse() const { return exitingHouse; }
+    bool isEnteringHouse() const { return enteringHouse; }
+    float getHouseTimer() const { return houseTimer; }
+    int getExitPhase() const { return exitPhase; }
     
     // Animación
     int getAnimFrame() const { return animFrame; }
     bool isBlinking() const { return blinking; }
+    bool isBlinkWhite() const { return blinking && blinkState; }  // Fase blanca del parpadeo
     void setBlinking(bool b) { blinking = b; }
-    
-    // Render
-    void render(SDL_Renderer* renderer);
-    
+
 private:
     GhostType type;
     GhostMode mode = GhostMode::Scatter;
-    float speedMultiplier = 1.0f;
+    int speedPercent = 100;
     
-    Vector2 target;
+    Vector2i target;
+    uint32_t randomBits = 0;
     
     // Casa de fantasmas
     bool inHouse = true;
@@ -69,6 +65,10 @@ private:
     float houseTimer = 0.0f;
     int exitPhase = 0;  // 0=esperar, 1=centrar X, 2=subir
     
+    // Último tile donde se tomó una decisión (una sola por tile)
+    int decisionTileX = -1;
+    int decisionTileY = -1;
+    
     // Animación
     int animFrame = 0;
     float animTimer = 0.0f;
@@ -77,11 +77,15 @@ private:
     bool blinkState = false;
     
     // Movimiento
-    bool canMove(Direction dir) const;
-    Direction chooseDirection() const;
-    void handleTunnelWrap();
-    float getExitDelay() const;
+    Direction chooseDirection(const Map& map) const;
+    Direction followCorridor(uint8_t exits) const;
+    void clearDecisionTile() { decisionTileX = -1; decisionTileY = -1; }
+    
+    // Acceso de Bench.cpp a chooseDirection (solo microbenchmarks)
+    friend struct BenchAccess;
     
-    // Gráficos
-    std::string getTextureKey() const;
+    // Implementación de Entity (CRTP)
+    friend class Entity<Ghost>;
+    void onUpdate(float dt, Map& map);
+    void onReset();
 };
@@ -2,165 +2,119 @@
 // IA fiel al Pac-Man arcade original
 #include "GhostAI.h"
 #include "Constants.h"
-#include <cmath>
 
-// Helper: convertir tile a posición en píxeles
-static Vector2 tileToPixel(int x, int y) {
-    return Vector2(
-        static_cast<float>(x * TILE_SIZE * SCALE),
-        static_cast<float>(y * TILE_SIZE * SCALE)
-    );
-}
-
-Vector2 GhostAI::getTarget(const Ghost& ghost, const PacMan& pacman, const Ghost* blinky) {
-    GhostMode mode = ghost.getMode();
-    
-    // Modo Eyes: ir a la casa
-    if (mode == GhostMode::Eyes) {
-        return tileToPixel(GHOST_HOUSE_X, 11);
-    }
-    
-    // Modo Frightened: movimiento aleatorio (ia de fantasmas invertida para esto)
-    if (mode == GhostMode::Frightened) {
-        // En el original es aleatorio, pero para simplificar huyen de Pac-Man
-        return Vector2(pacman.position.x, pacman.position.y);
-    }
+void GhostAI::initLanes(GhostLanes& lanes, const std::vector<Ghost>& ghosts) {
+    lanes = GhostLanes();
+    lanes.count = static_cast<int>(ghosts.size() < MAX_GHOSTS ? ghosts.size() : MAX_GHOSTS);
     
-    // Modo Scatter: ir a esquina asignada
-    if (mode == GhostMode::Scatter) {
-        return getScatterTarget(ghost.getType());
+    for (int i = 0; i < MAX_GHOSTS; i++) {
+        lanes.partner[i] = -1;
     }
     
-    // Modo Chase: según el tipo de fantasma
-    switch (ghost.getType()) {
-        case GhostType::Blinky:
-            return getBlinkyTarget(pacman);
-        case GhostType::Pinky:
-            return getPinkyTarget(pacman);
-        case GhostType::Inky:
-            return getInkyTarget(pacman, blinky);
-        case GhostType::Clyde:
-            return getClydeTarget(ghost, pacman);
-        default:
-            return getBlinkyTarget(pacman);
+    for (int i = 0; i < lanes.count; i++) {
+        const GhostTraits& traits = ghostTraits(ghosts[i].getType());
+        
+        lanes.lookahead[i] = traits.lookahead;
+        lanes.scatterX[i] = traits.scatterX;
+        lanes.scatterY[i] = traits.scatterY;
+        lanes.shyRadius[i] = traits.shyRadius;
+        
+        // Compañero: el primer fantasma del tipo indicado
+        for (int j = 0; traits.partnerType >= 0 && j < lanes.count; j++) {
+            if (static_cast<int>(ghosts[j].getType()) == traits.partnerType) {
+                lanes.partner[i] = j;
+                break;
+            }
+        }
+        
+        // Sin compañero (p. ej. Inky sin Blinky) persigue como Blinky
+        if (traits.partnerType >= 0 && lanes.partner[i] < 0) {
+            lanes.lookahead[i] = 0;
+        }
     }
 }
 
-// BLINKY (Rojo) - "Shadow"
-// Persigue directamente a Pac-Man
-Vector2 GhostAI::getBlinkyTarget(const PacMan& pacman) {
-    return Vector2(pacman.position.x, pacman.position.y);
+void GhostAI::gatherLanes(GhostLanes& lanes, const std::vector<Ghost>& ghosts) {
+    for (int i = 0; i < lanes.count; i++) {
+        lanes.tileX[i] = ghosts[i].getTileX();
+        lanes.tileY[i] = ghosts[i].getTileY();
+        lanes.mode[i] = static_cast<int32_t>(ghosts[i].getMode());
+    }
 }
 
-// PINKY (Rosa) - "Speedy"
-// Apunta 4 tiles delante de Pac-Man
-Vector2 GhostAI::getPinkyTarget(const PacMan& pacman) {
-    int px = pacman.getTileX();
-    int py = pacman.getTileY();
-    
-    // 4 tiles delante
-    switch (pacman.direction) {
-        case Direction::Up:
-            py -= 4;
-            // Bug del arcade original: también se mueve 4 a la izquierda cuando va arriba
-            px -= 4;
-            break;
-        case Direction::Down:
-            py += 4;
-            break;
-        case Direction::Left:
-            px -= 4;
-            break;
-        case Direction::Right:
-            px += 4;
-            break;
-        default:
-            break;
-    }
-    
-    return tileToPixel(px, py);
+// mask es 0 o -1 (todos los bits): elige a o b sin saltos
+static inline int select(int mask, int a, int b) {
+    return (a & mask) | (b & ~mask);
 }
 
-// INKY (Cyan) - "Bashful"
-// Emboscada compleja: dibuja vector desde Blinky a 2 tiles delante de Pac-Man,
-// luego duplica ese vector
-Vector2 GhostAI::getInkyTarget(const PacMan& pacman, const Ghost* blinky) {
-    if (!blinky) {
-        return getBlinkyTarget(pacman);
-    }
+void GhostAI::computeTargets(GhostLanes& lanes, const PacMan& pacman) {
+    const int px = pacman.getTileX();
+    const int py = pacman.getTileY();
+    const int pacX = pacman.getPosition().x;
+    const int pacY = pacman.getPosition().y;
     
-    int px = pacman.getTileX();
-    int py = pacman.getTileY();
-    
-    // 2 tiles delante de Pac-Man
+    // Paso por tile delante de Pac-Man.
+    // Bug del arcade original: hacia arriba también se desplaza a la izquierda.
+    int stepX = 0;
+    int stepY = 0;
     switch (pacman.direction) {
-        case Direction::Up:
-            py -= 2;
-            px -= 2;  // Bug del original
-            break;
-        case Direction::Down:
-            py += 2;
-            break;
-        case Direction::Left:
-            px -= 2;
-            break;
-        case Direction::Right:
-            px += 2;
-            break;
-        default:
-            break;
+        case Direction::Up:    stepX = -1; stepY = -1; break;
+        case Direction::Down:  stepY = 1;  break;
+        case Direction::Left:  stepX = -1; break;
+        case Direction::Right: stepX = 1;  break;
+        default: break;
     }
     
-    // Vector desde Blinky al punto delante de Pac-Man
-    int bx = blinky->getTileX();
-    int by = blinky->getTileY();
-    
-    int vx = px - bx;
-    int vy = py - by;
-    
-    // Duplicar el vector
-    int targetX = px + vx;
-    int targetY = py + vy;
-    
-    return tileToPixel(targetX, targetY);
-}
-
-// CLYDE (Naranja) - "Pokey"
-// Si está a más de 8 tiles de Pac-Man: perseguir como Blinky
-// Si está a 8 tiles o menos: ir a su esquina de scatter
-Vector2 GhostAI::getClydeTarget(const Ghost& clyde, const PacMan& pacman) {
-    int gx = clyde.getTileX();
-    int gy = clyde.getTileY();
-    int px = pacman.getTileX();
-    int py = pacman.getTileY();
+    // Tile del compañero (Blinky para Inky); se lee antes de la pasada para
+    // que todos los carriles usen las posiciones del mismo tick
+    int32_t partnerX[MAX_GHOSTS] = {};
+    int32_t partnerY[MAX_GHOSTS] = {};
+    for (int i = 0; i < lanes.count; i++) {
+        int p = lanes.partner[i];
+        partnerX[i] = (p >= 0) ? lanes.tileX[p] : 0;
+        partnerY[i] = (p >= 0) ? lanes.tileY[p] : 0;
+    }
     
-    // Distancia en tiles
-    float dist = std::sqrt(
-        static_cast<float>((gx - px) * (gx - px) + (gy - py) * (gy - py))
-    );
+    const int houseX = tileToFixed(GHOST_HOUSE_X);
+    const int houseY = tileToFixed(11);
     
-    if (dist > 8) {
-        // Perseguir como Blinky
-        return Vector2(pacman.position.x, pacman.position.y);
-    }
-    else {
-        // Ir a esquina
-        return getScatterTarget(GhostType::Clyde);
-    }
-}
-
-// Esquinas de scatter para cada fantasma
-Vector2 GhostAI::getScatterTarget(GhostType type) {
-    switch (type) {
-        case GhostType::Blinky:
-            return tileToPixel(BLINKY_SCATTER_X, BLINKY_SCATTER_Y);
-        case GhostType::Pinky:
-            return tileToPixel(PINKY_SCATTER_X, PINKY_SCATTER_Y);
-        case GhostType::Inky:
-            return tileToPixel(INKY_SCATTER_X, INKY_SCATTER_Y);
-        case GhostType::Clyde:
-            return tileToPixel(CLYDE_SCATTER_X, CLYDE_SCATTER_Y);
-        default:
-            return tileToPixel(MAP_WIDTH / 2, MAP_HEIGHT / 2);
+    // Una iteración por carril, solo aritmética y máscaras (sin saltos):
+    // el compilador la vectoriza
+    for (int i = 0; i < MAX_GHOSTS; i++) {
+        int aheadX = px + lanes.lookahead[i] * stepX;
+        int aheadY = py + lanes.lookahead[i] * stepY;
+        
+        // Inky: duplicar el vector desde su compañero hasta el punto delante de Pac-Man
+        int hasPartner = -(lanes.partner[i] >= 0);
+        int chaseTileX = aheadX + (hasPartner & (aheadX - partnerX[i]));
+        int chaseTileY = aheadY + (hasPartner & (aheadY - partnerY[i]));
+        
+        // Sin adelanto ni compañero se persigue la posición exacta de Pac-Man
+        int exact = -(lanes.lookahead[i] == 0) & ~hasPartner;
+        int chaseX = select(exact, pacX, tileToFixed(chaseTileX));
+        int chaseY = select(exact, pacY, tileToFixed(chaseTileY));
+        
+        // Clyde: demasiado cerca de Pac-Man -> a su esquina
+        int dx = lanes.tileX[i] - px;
+        int dy = lanes.tileY[i] - py;
+        int radius = lanes.shyRadius[i];
+        int shy = -(radius > 0) & -(dx * dx + dy * dy <= radius * radius);
+        
+        int mode = lanes.mode[i];
+        int isChase = -(mode == static_cast<int>(GhostMode::Chase));
+        int toScatter = -(mode == static_cast<int>(GhostMode::Scatter)) | (isChase & shy);
+        // Frightened decide al azar (Ghost::chooseDirection); el objetivo no se usa
+        int toPacman = -(mode == static_cast<int>(GhostMode::Frightened));
+        int toHouse = -(mode == static_cast<int>(GhostMode::Eyes));
+        
+        int tx = select(toHouse, houseX, chaseX);
+        int ty = select(toHouse, houseY, chaseY);
+        tx = select(toPacman, pacX, tx);
+        ty = select(toPacman, pacY, ty);
+        tx = select(toScatter, tileToFixed(lanes.scatterX[i]), tx);
+        ty = select(toScatter, tileToFixed(lanes.scatterY[i]), ty);
+        
+        lanes.targetX[i] = tx;
+        lanes.targetY[i] = ty;
     }
 }
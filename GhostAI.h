@@ -5,23 +5,42 @@
 #include "Ghost.h"
 #include "Pacman.h"
 #include "Math.h"
+#include <cstdint>
+#include <vector>
+
+constexpr int MAX_GHOSTS = 8;  // Ancho fijo de los carriles (4 fantasmas del arcade + extras)
+
+// Estado de IA de los fantasmas como arrays paralelos (un carril por fantasma).
+// La personalidad se carga una vez; tiles y modos se refrescan cada tick
+// y los objetivos se calculan para todos en una sola pasada.
+struct GhostLanes {
+    int count = 0;
+    
+    // Personalidad (fija por fantasma)
+    int32_t lookahead[MAX_GHOSTS] = {};   // Tiles delante de Pac-Man
+    int32_t scatterX[MAX_GHOSTS] = {};    // Esquina de scatter (tiles)
+    int32_t scatterY[MAX_GHOSTS] = {};
+    int32_t partner[MAX_GHOSTS] = {};     // Carril de referencia para duplicar el vector (-1 = ninguno)
+    int32_t shyRadius[MAX_GHOSTS] = {};   // Radio (tiles) en que huye a su esquina (0 = nunca)
+    
+    // Estado caliente (se refresca cada tick)
+    int32_t tileX[MAX_GHOSTS] = {};
+    int32_t tileY[MAX_GHOSTS] = {};
+    int32_t mode[MAX_GHOSTS] = {};        // GhostMode
+    
+    // Salida: objetivo en punto fijo
+    int32_t targetX[MAX_GHOSTS] = {};
+    int32_t targetY[MAX_GHOSTS] = {};
+};
 
 class GhostAI {
 public:
-    // Calcula el objetivo para cada fantasma según su tipo y modo
-    static Vector2 getTarget(
-        const Ghost& ghost,
-        const PacMan& pacman,
-        const Ghost* blinky = nullptr  // Necesario para Inky
-    );
+    // Carga la personalidad de cada fantasma desde la tabla de políticas
+    static void initLanes(GhostLanes& lanes, const std::vector<Ghost>& ghosts);
     
-private:
-    // Objetivos en modo Chase
-    static Vector2 getBlinkyTarget(const PacMan& pacman);
-    static Vector2 getPinkyTarget(const PacMan& pacman);
-    static Vector2 getInkyTarget(const PacMan& pacman, const Ghost* blinky);
-    static Vector2 getClydeTarget(const Ghost& clyde, const PacMan& pacman);
+    // Copia tiles y modos actuales a los carriles
+    static void gatherLanes(GhostLanes& lanes, const std::vector<Ghost>& ghosts);
     
-    // Objetivos en modo Scatter (esquinas)
-    static Vector2 getScatterTarget(GhostType type);
+    // Calcula el objetivo de todos los fantasmas en una pasada sin saltos
+    static void computeTargets(GhostLanes& lanes, const PacMan& pacman);
 };
@@ -0,0 +1,136 @@
+// GhostPersonality.h
+// Personalidades de los fantasmas como políticas de compilación
+#pragma once
+
+#include "Constants.h"
+#include "Direction.h"
+
+enum class GhostType {
+    Blinky,  // Rojo
+    Pinky,   // Rosa
+    Inky,    // Cyan
+    Clyde    // Naranja
+};
+
+// Fila de la tabla de personalidades (la leen Ghost y GhostAI, sin switches)
+struct GhostTraits {
+    GhostType type;
+    
+    // Inicio (posición en punto fijo)
+    int startX;
+    int startY;
+    Direction startDirection;
+    bool startsInHouse;
+    float exitDelay;          // Segundos en la casa antes de salir
+    
+    // Gráficos
+    const char* color;        // ghost_<color>_<dir>_<frame>
+    
+    // IA en modo Chase/Scatter
+    int lookahead;            // Tiles delante de Pac-Man
+    int scatterX;             // Esquina de scatter (tiles)
+    int scatterY;
+    int partnerType;          // GhostType de referencia para duplicar el vector (-1 = ninguno)
+    int shyRadius;            // Radio (tiles) en que huye a su esquina (0 = nunca)
+};
+
+// Centro horizontal de una columna de la casa, en punto fijo
+constexpr int houseColumnX(int tileX) { return tileToFixed(tileX) + FIXED_TILE / 2; }
+
+// BLINKY (Rojo) - "Shadow": empieza fuera de la casa y persigue directamente a Pac-Man
+struct BlinkyPolicy {
+    static constexpr GhostType type = GhostType::Blinky;
+    static constexpr int startX = houseColumnX(GHOST_HOUSE_X);
+    static constexpr int startY = tileToFixed(GHOST_HOUSE_Y - 3);  // Arriba de la puerta
+    static constexpr Direction startDirection = Direction::Left;
+    static constexpr bool startsInHouse = false;
+    static constexpr float exitDelay = 0.0f;
+    static constexpr const char* color = "red";
+    static constexpr int lookahead = 0;
+    static constexpr int scatterX = BLINKY_SCATTER_X;
+    static constexpr int scatterY = BLINKY_SCATTER_Y;
+    static constexpr int partnerType = -1;
+    static constexpr int shyRadius = 0;
+};
+
+// PINKY (Rosa) - "Speedy": centro de la casa, apunta 4 tiles delante de Pac-Man
+struct PinkyPolicy {
+    static constexpr GhostType type = GhostType::Pinky;
+    static constexpr int startX = houseColumnX(GHOST_HOUSE_X);
+    static constexpr int startY = tileToFixed(GHOST_HOUSE_Y);
+    static constexpr Direction startDirection = Direction::Down;
+    static constexpr bool startsInHouse = true;
+    static constexpr float exitDelay = 0.0f;
+    static constexpr const char* color = "pink";
+    static constexpr int lookahead = 4;
+    static constexpr int scatterX = PINKY_SCATTER_X;
+    static constexpr int scatterY = PINKY_SCATTER_Y;
+    static constexpr int partnerType = -1;
+    static constexpr int shyRadius = 0;
+};
+
+// INKY (Cyan) - "Bashful": izquierda de la casa, duplica el vector
+// desde Blinky hasta 2 tiles delante de Pac-Man
+struct InkyPolicy {
+    static constexpr GhostType type = GhostType::Inky;
+    static constexpr int startX = houseColumnX(GHOST_HOUSE_X - 2);
+    static constexpr int startY = tileToFixed(GHOST_HOUSE_Y);
+    static constexpr Direction startDirection = Direction::Up;
+    static constexpr bool startsInHouse = true;
+    static constexpr float exitDelay = 3.0f;   // Reducido para que salga antes
+    static constexpr const char* color = "blue";
+    static constexpr int lookahead = 2;
+    static constexpr int scatterX = INKY_SCATTER_X;
+    static constexpr int scatterY = INKY_SCATTER_Y;
+    static constexpr int partnerType = static_cast<int>(GhostType::Blinky);
+    static constexpr int shyRadius = 0;
+};
+
+// CLYDE (Naranja) - "Pokey": derecha de la casa, persigue como Blinky
+// pero a 8 tiles o menos de Pac-Man se va a su esquina
+struct ClydePolicy {
+    static constexpr GhostType type = GhostType::Clyde;
+    static constexpr int startX = houseColumnX(GHOST_HOUSE_X + 2);
+    static constexpr int startY = tileToFixed(GHOST_HOUSE_Y);
+    static constexpr Direction startDirection = Direction::Up;
+    static constexpr bool startsInHouse = true;
+    static constexpr float exitDelay = 6.0f;   // Reducido
+    static constexpr const char* color = "orange";
+    static constexpr int lookahead = 0;
+    static constexpr int scatterX = CLYDE_SCATTER_X;
+    static constexpr int scatterY = CLYDE_SCATTER_Y;
+    static constexpr int partnerType = -1;
+    static constexpr int shyRadius = 8;
+};
+
+template <typename Policy>
+constexpr GhostTraits makeGhostTraits() {
+    return {Policy::type, Policy::startX, Policy::startY, Policy::startDirection,
+            Policy::startsInHouse, Policy::exitDelay, Policy::color,
+            Policy::lookahead, Policy::scatterX, Policy::scatterY,
+            Policy::partnerType, Policy::shyRadius};
+}
+
+// Tabla generada en compilación a partir de la lista de políticas.
+// Para agregar una personalidad: nuevo GhostType, nueva política y agregarla aquí.
+template <typename... Policies>
+struct GhostPolicyList {
+    static constexpr int count = sizeof...(Policies);
+    static constexpr GhostTraits table[count] = {makeGhostTraits<Policies>()...};
+    
+    // La fila i debe ser la del GhostType i
+    static constexpr bool ordered() {
+        for (int i = 0; i < count; i++) {
+            if (static_cast<int>(table[i].type) != i)
+                return false;
+        }
+        return true;
+    }
+};
+
+using GhostPersonalities = GhostPolicyList<BlinkyPolicy, PinkyPolicy, InkyPolicy, ClydePolicy>;
+static_assert(GhostPersonalities::ordered(), "GhostPersonalities debe seguir el orden de GhostType");
+
+inline const GhostTraits& ghostTraits(GhostType type) {
+    return GhostPersonalities::table[static_cast<int>(type)];
+}
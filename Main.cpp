@@ -1,44 +1,332 @@
 // Main.cpp
 // Punto de entrada del juego Pac-Man
 #include "Game.h"
+#include "GameCore.h"
+#include "Replay.h"
+#include "Autopilot.h"
+#include "Profiler.h"
+#include "FrameStats.h"
+#include "MetricsServer.h"
 #include <SDL2/SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Modo headless: simula sin ventana, sin mixer y sin límite de frames.
+// Pac-Man gira a la siguiente dirección cada vez que choca con una pared,
+// o lo maneja el piloto automático si se pasa uno.
+static int runHeadless(long frames, uint32_t seed, Autopilot* autopilot) {
+    GameCore core(seed);
+    core.startGame();
+    
+    const Direction turns[] = {Direction::Up, Direction::Left, Direction::Down, Direction::Right};
+    int turn = 0;
+    int games = 0;
+    int bestScore = 0;
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    for (long frame = 0; frame < frames; frame++) {
+        if (autopilot) {
+            Direction dir = autopilot->decide(core);
+            if (dir != Direction::None) core.setDesiredDirection(dir);
+        }
+        else if (core.getState() == GameState::Playing &&
+                 core.getPacman().direction == Direction::None) {
+            turn = (turn + 1) % 4;
+            core.setDesiredDirection(turns[turn]);
+        }
+        
+        core.update();
+        
+        if (core.getState() == GameState::GameOver) {
+            games++;
+            if (core.getScore() > bestScore) bestScore = core.getScore();
+            core.newGame();
+        }
+    }
+    
+    auto end = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    
+    std::cout << "frames: " << frames
+              << "  time: " << ms << " ms"
+              << "  frames/ms: " << (ms > 0.0 ? frames / ms : 0.0) << std::endl;
+    std::cout << "seed: " << seed << std::endl;
+    std::cout << "games over: " << games
+              << "  best score: " << bestScore
+              << "  current score: " << core.getScore()
+              << "  level: " << core.getLevel() << std::endl;
+    
+    if (autopilot) {
+        std::cout << "autopilot: " << autopilot->getThreadCount() << " threads"
+                  << "  rollouts: " << autopilot->getRollouts()
+                  << "  rollouts/s: " << static_cast<long>(autopilot->getRolloutsPerSecond()) << std::endl;
+    }
+    
+    return 0;
+}
+
+// Reproduce un replay sin ventana y sin límite de frames.
+// Con hashLogPath guarda además el hash del estado de cada tick.
+static int runReplay(const std::string& path, const std::string& hashLogPath) {
+    Replay replay;
+    if (!replay.load(path)) {
+        std::cerr << "Could not load replay: " << path << std::endl;
+        return -1;
+    }
+    
+    GameCore core(replay.seed);
+    core.setStartLevel(replay.level);
+    ReplayPlayer player(replay);
+    
+    std::vector<uint64_t> hashLog;
+    bool logHashes = !hashLogPath.empty();
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    while (!player.isFinished(core.getTick())) {
+        player.applyDue(core.getTick(), [&core](PlayerAction a) { applyPlayerAction(core, a); });
+        core.update();
+        if (logHashes) hashLog.push_back(core.getHash());
+    }
+    
+    auto end = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    
+    std::cout << "replay: " << path
+              << "  ticks: " << replay.length
+              << "  inputs: " << replay.inputs.size()
+              << "  time: " << ms << " ms" << std::endl;
+    std::cout << "seed: " << replay.seed
+              << "  score: " << core.getScore()
+              << "  level: " << core.getLevel()
+              << "  lives: " << core.getLives() << std::endl;
+    
+    if (logHashes && !saveHashLog(hashLogPath, hashLog)) {
+        std::cerr << "Could not save hash log: " << hashLogPath << std::endl;
+        return -1;
+    }
+    
+    return 0;
+}
+
+// Busca el primer tick en que dos ejecuciones divergen. Cada archivo puede
+// ser un replay (se simula) o un log de hashes (--hash-log).
+static int runBisect(const std::string& pathA, const std::string& pathB) {
+    std::vector<uint64_t> logs[2];
+    const std::string* paths[2] = {&pathA, &pathB};
+    
+    for (int i = 0; i < 2; i++) {
+        Replay replay;
+        if (replay.load(*paths[i])) {
+            logs[i] = computeHashLog(replay);
+        }
+        else if (!loadHashLog(*paths[i], logs[i])) {
+            std::cerr << "Could not load replay or hash log: " << *paths[i] << std::endl;
+            return -1;
+        }
+    }
+    
+    long tick = findDivergence(logs[0], logs[1]);
+    if (tick < 0) {
+        std::cout << "no divergence in " << std::min(logs[0].size(), logs[1].size()) << " ticks";
+        if (logs[0].size() != logs[1].size()) {
+            std::cout << " (lengths differ: " << logs[0].size() << " vs " << logs[1].size() << ")";
+        }
+        std::cout << std::endl;
+        return 0;
+    }
+    
+    std::cout << "first divergent tick: " << tick << std::hex
+              << "  hash A: " << logs[0][tick - 1]
+              << "  hash B: " << logs[1][tick - 1] << std::dec << std::endl;
+    return 1;
+}
 
 int main(int argc, char* argv[]) {
-    (void)argc;
-    (void)argv;
+    bool headless = false;
+    long headlessFrames = 100000;
+    uint32_t seed = GameRandom::DEFAULT_SEED;
+    std::string recordPath;
+    std::string replayPath;
+    bool realtime = false;
+    std::string hashLogPath;
+    std::string bisectA;
+    std::string bisectB;
+    bool useAutopilot = false;
+    std::string profilePath;
+    double profileSeconds = 10.0;
+    std::string metricsSocket;
+    AutopilotConfig autopilotConfig;
+    
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        }
+        else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            headlessFrames = std::atol(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 0));
+        }
+        else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--realtime") == 0) {
+            realtime = true;
+        }
+        else if (std::strcmp(argv[i], "--hash-log") == 0 && i + 1 < argc) {
+            hashLogPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--autopilot") == 0) {
+            useAutopilot = true;
+        }
+        else if (std::strcmp(argv[i], "--budget") == 0 && i + 1 < argc) {
+            autopilotConfig.budgetMs = static_cast<float>(std::atof(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--rollouts") == 0 && i + 1 < argc) {
+            autopilotConfig.maxRollouts = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            autopilotConfig.threads = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            profilePath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--profile-seconds") == 0 && i + 1 < argc) {
+            profileSeconds = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--metrics-socket") == 0 && i + 1 < argc) {
+            metricsSocket = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--bisect") == 0 && i + 2 < argc) {
+            bisectA = argv[++i];
+            bisectB = argv[++i];
+        }
+    }
+    
+    // Headless corre su propia partida: no combina con replays ni bisect
+    if (headless && (!replayPath.empty() || !bisectA.empty())) {
+        std::cerr << "--headless cannot be combined with --replay or --bisect" << std::endl;
+        return -1;
+    }
+    
+    if (headless) {
+        std::unique_ptr<Autopilot> autopilot;
+        if (useAutopilot) autopilot.reset(new Autopilot(autopilotConfig));
+        
+        // En headless solo se graba si se pidió un trace
+        if (!profilePath.empty()) Profiler::registerThread("main");
+        int result = runHeadless(headlessFrames, seed, autopilot.get());
+        if (!profilePath.empty() && !Profiler::dumpChromeTrace(profilePath, profileSeconds)) {
+            std::cerr << "Could not write profile: " << profilePath << std::endl;
+        }
+        return result;
+    }
+    
+    if (!bisectA.empty()) {
+        return runBisect(bisectA, bisectB);
+    }
+    
+    // Por defecto los replays se reproducen a máxima velocidad sin ventana
+    if (!replayPath.empty() && !realtime) {
+        return runReplay(replayPath, hashLogPath);
+    }
     
     Game game;
     
+    if (!replayPath.empty()) {
+        if (!game.startReplay(replayPath)) {
+            std::cerr << "Could not load replay: " << replayPath << std::endl;
+            return -1;
+        }
+    }
+    else {
+        game.setSeed(seed);
+        if (!recordPath.empty()) game.setRecordPath(recordPath);
+    }
+    
+    if (useAutopilot) {
+        game.setAutopilot(autopilotConfig);
+    }
+    
+    if (!profilePath.empty()) {
+        game.setProfileOutput(profilePath, profileSeconds, true);
+    }
+    
     if (!game.init()) {
         std::cerr << "Failed to initialize game" << std::endl;
         return -1;
     }
     
-    // Game loop
-    Uint32 lastTicks = SDL_GetTicks();
-    const float targetFrameTime = 1.0f / 60.0f;  // 60 FPS
+    // Tiempos de frame, simulación y render (siempre activos; el reporte
+    // sale al cerrar y, con --metrics-socket, también por el socket)
+    FrameStats frameStats;
+    MetricsServer metricsServer;
+    if (!metricsSocket.empty()) {
+        bool started = metricsServer.start(metricsSocket, [&frameStats](std::string& out) {
+            frameStats.writePrometheus(out);
+        });
+        if (!started) {
+            std::cerr << "Could not open metrics socket: " << metricsSocket << std::endl;
+        }
+    }
+    
+    // Game loop a paso fijo: la simulación avanza en ticks de SIM_DT
+    // y el render interpola entre los dos últimos ticks
+    const Uint64 perfFrequency = SDL_GetPerformanceFrequency();
+    const double nsPerCount = 1e9 / perfFrequency;
+    Uint64 lastCounter = SDL_GetPerformanceCounter();
+    float accumulator = 0.0f;
     
     while (game.isRunning()) {
-        Uint32 currentTicks = SDL_GetTicks();
-        float deltaTime = (currentTicks - lastTicks) / 1000.0f;
-        lastTicks = currentTicks;
+        Uint64 currentCounter = SDL_GetPerformanceCounter();
+        float frameTime = static_cast<float>(currentCounter - lastCounter) / perfFrequency;
+        frameStats.frame.record(static_cast<uint64_t>((currentCounter - lastCounter) * nsPerCount));
+        lastCounter = currentCounter;
         
-        // Limitar deltaTime para evitar problemas
-        if (deltaTime > 0.1f) {
-            deltaTime = 0.1f;
-        }
+        accumulator += frameTime;
         
         game.handleInput();
-        game.update(deltaTime);
-        game.render();
         
-        // Frame rate limiting
-        Uint32 frameTime = SDL_GetTicks() - currentTicks;
-        if (frameTime < 16) {
-            SDL_Delay(16 - frameTime);
+        // Limitar los ticks de recuperación para acotar el costo en frames lentos
+        Uint64 simStart = SDL_GetPerformanceCounter();
+        int steps = 0;
+        while (accumulator >= SIM_DT && steps < MAX_SIM_STEPS_PER_FRAME) {
+            game.update(SIM_DT);
+            accumulator -= SIM_DT;
+            steps++;
+        }
+        Uint64 simEnd = SDL_GetPerformanceCounter();
+        frameStats.sim.record(static_cast<uint64_t>((simEnd - simStart) * nsPerCount));
+        frameStats.addSimTicks(steps);
+        
+        // Si no alcanzamos, descartar el tiempo atrasado en vez de acumularlo
+        if (steps == MAX_SIM_STEPS_PER_FRAME && accumulator >= SIM_DT) {
+            accumulator = 0.0f;
+            frameStats.addDroppedCatchUp();
+        }
+        
+        game.render(accumulator / SIM_DT);
+        frameStats.render.record(static_cast<uint64_t>((SDL_GetPerformanceCounter() - simEnd) * nsPerCount));
+        
+        // El ritmo lo marca el VSync; solo ceder CPU si el frame fue instantáneo
+        float elapsed = static_cast<float>(SDL_GetPerformanceCounter() - currentCounter) / perfFrequency;
+        if (elapsed < 0.001f) {
+            SDL_Delay(1);
         }
     }
     
+    metricsServer.stop();
+    frameStats.printReport(std::cout);
     return 0;
 }
@@ -1,92 +1,87 @@
 // Map.cpp
 // Laberinto fiel al Pac-Man arcade original
 #include "Map.h"
+#include <cstring>
 
-Map& Map::get() {
-    static Map instance;
-    return instance;
+// Todas las partidas arrancan con el laberinto original: una sola tabla para todas
+static std::shared_ptr<const MazeDistances> originalDistances(const Map& original) {
+    static const std::shared_ptr<const MazeDistances> shared =
+        std::make_shared<const MazeDistances>(original);
+    return shared;
 }
 
 Map::Map() {
-    loadMap();
-}
-
-void Map::loadMap() {
-    // Mapa del Pac-Man arcade original
-    // # = Pared
-    // . = Dot
-    // o = Power Pellet
-    // - = Puerta de la casa de fantasmas
-    // T = Túnel
-    // (espacio) = Vacío
-    
-    const char* rawMap[MAP_HEIGHT] = {
-        "############################",  // 0
-        "#............##............#",  // 1
-        "#.####.#####.##.#####.####.#",  // 2
-        "#o####.#####.##.#####.####o#",  // 3
-        "#.####.#####.##.#####.####.#",  // 4
-        "#..........................#",  // 5
-        "#.####.##.########.##.####.#",  // 6
-        "#.####.##.########.##.####.#",  // 7
-        "#......##....##....##......#",  // 8
-        "######.##### ## #####.######",  // 9
-        "     #.##### ## #####.#     ",  // 10
-        "     #.##          ##.#     ",  // 11
-        "     #.## ###--### ##.#     ",  // 12
-        "######.## #      # ##.######",  // 13
-        "TTTTTT.   #      #   .TTTTTT",  // 14 - Túnel
-        "######.## #      # ##.######",  // 15
-        "     #.## ######## ##.#     ",  // 16
-        "     #.##          ##.#     ",  // 17
-        "     #.## ######## ##.#     ",  // 18
-        "######.## ######## ##.######",  // 19
-        "#............##............#",  // 20
-        "#.####.#####.##.#####.####.#",  // 21
-        "#o..##................##..o#",  // 22
-        "###.##.##.########.##.##.###",  // 23
-        "###.##.##.########.##.##.###",  // 24
-        "#......##....##....##......#",  // 25
-        "#.##########.##.##########.#",  // 26
-        "#.##########.##.##########.#",  // 27
-        "#..........................#",  // 28
-        "############################",  // 29
-        "############################"   // 30
-    };
-    
-    totalDots = 0;
-    remainingDots = 0;
-    
-    for (int y = 0; y < MAP_HEIGHT; y++) {
-        for (int x = 0; x < MAP_WIDTH; x++) {
-            char c = rawMap[y][x];
-            switch (c) {
-                case '#': 
-                    tiles[y][x] = TileType::Wall; 
-                    break;
-                case '.': 
-                    tiles[y][x] = TileType::Dot;
-                    totalDots++;
-                    remainingDots++;
-                    break;
-                case 'o': 
-                    tiles[y][x] = TileType::PowerPellet;
-                    totalDots++;
-                    remainingDots++;
-                    break;
-                case '-': 
-                    tiles[y][x] = TileType::GhostDoor; 
-                    break;
-                case 'T':
-                    tiles[y][x] = TileType::Tunnel;
-                    break;
-                case ' ':
-                default:
-                    tiles[y][x] = TileType::Empty;
-                    break;
+    // Las capas arrancan vacías: resetLevel ve un laberinto distinto y arma las tablas
+    resetLevel();
+    totalDots = remainingDots;
+}
+
+const MapLayers& Map::initialLayers() {
+    static const MapLayers layers = [] {
+        // Mapa del Pac-Man arcade original
+        // # = Pared
+        // . = Dot
+        // o = Power Pellet
+        // - = Puerta de la casa de fantasmas
+        // T = Túnel
+        // (espacio) = Vacío
+        
+        const char* rawMap[MAP_HEIGHT] = {
+            "############################",  // 0
+            "#............##............#",  // 1
+            "#.####.#####.##.#####.####.#",  // 2
+            "#o####.#####.##.#####.####o#",  // 3
+            "#.####.#####.##.#####.####.#",  // 4
+            "#..........................#",  // 5
+            "#.####.##.########.##.####.#",  // 6
+            "#.####.##.########.##.####.#",  // 7
+            "#......##....##....##......#",  // 8
+            "######.##### ## #####.######",  // 9
+            "     #.##### ## #####.#     ",  // 10
+            "     #.##          ##.#     ",  // 11
+            "     #.## ###--### ##.#     ",  // 12
+            "######.## #      # ##.######",  // 13
+            "TTTTTT.   #      #   .TTTTTT",  // 14 - Túnel
+            "######.## #      # ##.######",  // 15
+            "     #.## ######## ##.#     ",  // 16
+            "     #.##          ##.#     ",  // 17
+            "     #.## ######## ##.#     ",  // 18
+            "######.## ######## ##.######",  // 19
+            "#............##............#",  // 20
+            "#.####.#####.##.#####.####.#",  // 21
+            "#o..##................##..o#",  // 22
+            "###.##.##.########.##.##.###",  // 23
+            "###.##.##.########.##.##.###",  // 24
+            "#......##....##....##......#",  // 25
+            "#.##########.##.##########.#",  // 26
+            "#.##########.##.##########.#",  // 27
+            "#..........................#",  // 28
+            "############################",  // 29
+            "############################"   // 30
+        };
+        
+        MapLayers l = {};
+        
+        for (int y = 0; y < MAP_HEIGHT; y++) {
+            for (int x = 0; x < MAP_WIDTH; x++) {
+                uint32_t bit = 1u << x;
+                switch (rawMap[y][x]) {
+                    case '#': l.walls[y]   |= bit; break;
+                    case '.': l.dots[y]    |= bit; break;
+                    case 'o': l.pellets[y] |= bit; break;
+                    case '-': l.door[y]    |= bit; break;
+                    case 'T': l.tunnel[y]  |= bit; break;
+                    case ' ':
+                    default:
+                        break;
+                }
             }
         }
-    }
+        
+        return l;
+    }();
+    
+    return layers;
 }
 
 TileType Map::getTile(int x, int y) const {
@@ -96,14 +91,168 @@ TileType Map::getTile(int x, int y) const {
     
     if (y < 0 || y >= MAP_HEIGHT)
         return TileType::Wall;
-        
-    return tiles[y][x];
+    
+    uint32_t bit = 1u << x;
+    if (layers.walls[y] & bit)   return TileType::Wall;
+    if (layers.dots[y] & bit)    return TileType::Dot;
+    if (layers.pellets[y] & bit) return TileType::PowerPellet;
+    if (layers.door[y] & bit)    return TileType::GhostDoor;
+    if (layers.tunnel[y] & bit)  return TileType::Tunnel;
+    return TileType::Empty;
 }
 
 void Map::setTile(int x, int y, TileType type) {
     if (x < 0 || x >= MAP_WIDTH || y < 0 || y >= MAP_HEIGHT)
         return;
-    tiles[y][x] = type;
+    
+    bool wasWalkable = isWalkable(x, y, false);
+    
+    uint32_t bit = 1u << x;
+    layers.walls[y]   &= ~bit;
+    layers.dots[y]    &= ~bit;
+    layers.pellets[y] &= ~bit;
+    layers.door[y]    &= ~bit;
+    layers.tunnel[y]  &= ~bit;
+    
+    switch (type) {
+        case TileType::Wall:        layers.walls[y]   |= bit; break;
+        case TileType::Dot:         layers.dots[y]    |= bit; break;
+        case TileType::PowerPellet: layers.pellets[y] |= bit; break;
+        case TileType::GhostDoor:   layers.door[y]    |= bit; break;
+        case TileType::Tunnel:      layers.tunnel[y]  |= bit; break;
+        case TileType::Empty:       break;
+    }
+    
+    buildExitTables();
+    dotHash = computeDotHash();
+    
+    // El laberinto ya no es el original: tabla propia solo si cambió la caminabilidad
+    if (isWalkable(x, y, false) != wasWalkable) {
+        distances = std::make_shared<const MazeDistances>(*this);
+    }
+}
+
+int Map::getPathDistance(int x1, int y1, int x2, int y2) const {
+    int from = distances->getTileIndex(x1, y1);
+    int to = distances->getTileIndex(x2, y2);
+    if (from < 0 || to < 0)
+        return -1;
+    
+    uint16_t d = distances->distance(from, to);
+    return d == MazeDistances::UNREACHABLE ? -1 : d;
+}
+
+Direction Map::getNextHop(int x1, int y1, int x2, int y2) const {
+    int from = distances->getTileIndex(x1, y1);
+    int to = distances->getTileIndex(x2, y2);
+    if (from < 0 || to < 0)
+        return Direction::None;
+    
+    return distances->nextHop(from, to);
+}
+
+uint8_t Map::computeExits(int x, int y, bool isGhost) const {
+    uint8_t exits = 0;
+    if (isWalkable(x, y - 1, isGhost)) exits |= EXIT_UP;
+    if (isWalkable(x, y + 1, isGhost)) exits |= EXIT_DOWN;
+    if (isWalkable(x - 1, y, isGhost)) exits |= EXIT_LEFT;
+    if (isWalkable(x + 1, y, isGhost)) exits |= EXIT_RIGHT;
+    return exits;
+}
+
+void Map::buildExitTables() {
+    // Incluye el borde centinela: x en [-1, MAP_WIDTH], y en [-1, MAP_HEIGHT]
+    for (int y = -1; y <= MAP_HEIGHT; y++) {
+        for (int x = -1; x <= MAP_WIDTH; x++) {
+            uint8_t pacman = computeExits(x, y, false);
+            uint8_t ghost = computeExits(x, y, true);
+            
+            uint8_t flags = 0;
+            if (isTunnel(x, y)) flags |= TILE_TUNNEL;
+            if (popcount32(pacman) > 2) flags |= TILE_INTERSECTION;
+            
+            pacmanExits[y + 1][x + 1] = pacman | flags | (popcount32(pacman) > 2 ? TILE_DECISION : 0);
+            ghostExits[y + 1][x + 1] = ghost | flags | (popcount32(ghost) > 2 ? TILE_DECISION : 0);
+        }
+    }
+    
+    buildHomeFlow();
+}
+
+void Map::buildHomeFlow() {
+    // Prioridad del arcade para desempates: Up, Left, Down, Right
+    static const Direction dirs[] = {Direction::Up, Direction::Left, Direction::Down, Direction::Right};
+    static constexpr uint16_t UNVISITED = 0xFFFF;
+    
+    uint16_t dist[MAP_HEIGHT][MAP_WIDTH];
+    int queueX[MAP_WIDTH * MAP_HEIGHT];
+    int queueY[MAP_WIDTH * MAP_HEIGHT];
+    int head = 0;
+    int tail = 0;
+    
+    // Origen: los tiles caminables justo sobre la puerta
+    for (int y = 0; y < MAP_HEIGHT; y++) {
+        for (int x = 0; x < MAP_WIDTH; x++) {
+            dist[y][x] = UNVISITED;
+            homeFlow[y][x] = static_cast<uint8_t>(Direction::None);
+            
+            if (isWalkable(x, y, false) && getTile(x, y + 1) == TileType::GhostDoor) {
+                dist[y][x] = 0;
+                queueX[tail] = x;
+                queueY[tail] = y;
+                tail++;
+            }
+        }
+    }
+    
+    // BFS inverso con las salidas de fantasma (el grafo es simétrico)
+    while (head < tail) {
+        int x = queueX[head];
+        int y = queueY[head];
+        head++;
+        
+        uint8_t exits = getExits(x, y, true);
+        for (Direction d : dirs) {
+            if (!(exits & directionBit(d)))
+                continue;
+            
+            int nx = x + (d == Direction::Right) - (d == Direction::Left);
+            int ny = y + (d == Direction::Down) - (d == Direction::Up);
+            if (nx < 0) nx += MAP_WIDTH;
+            if (nx >= MAP_WIDTH) nx -= MAP_WIDTH;
+            
+            if (dist[ny][nx] == UNVISITED) {
+                dist[ny][nx] = dist[y][x] + 1;
+                queueX[tail] = nx;
+                queueY[tail] = ny;
+                tail++;
+            }
+        }
+    }
+    
+    // Cada tile apunta al vecino más cercano a la casa
+    for (int y = 0; y < MAP_HEIGHT; y++) {
+        for (int x = 0; x < MAP_WIDTH; x++) {
+            if (dist[y][x] == 0 || dist[y][x] == UNVISITED)
+                continue;
+            
+            uint8_t exits = getExits(x, y, true);
+            for (Direction d : dirs) {
+                if (!(exits & directionBit(d)))
+                    continue;
+                
+                int nx = x + (d == Direction::Right) - (d == Direction::Left);
+                int ny = y + (d == Direction::Down) - (d == Direction::Up);
+                if (nx < 0) nx += MAP_WIDTH;
+                if (nx >= MAP_WIDTH) nx -= MAP_WIDTH;
+                
+                if (dist[ny][nx] == dist[y][x] - 1) {
+                    homeFlow[y][x] = static_cast<uint8_t>(d);
+                    break;
+                }
+            }
+        }
+    }
 }
 
 bool Map::isWalkable(int x, int y, bool isGhost) const {
@@ -123,22 +272,19 @@ bool Map::isTunnel(int x, int y) const {
 }
 
 bool Map::isIntersection(int x, int y) const {
-    // Cuenta cuántas direcciones son transitables
-    int count = 0;
-    if (isWalkable(x, y - 1, false)) count++;
-    if (isWalkable(x, y + 1, false)) count++;
-    if (isWalkable(x - 1, y, false)) count++;
-    if (isWalkable(x + 1, y, false)) count++;
-    return count > 2;
+    // Más de 2 direcciones transitables (precalculado en la tabla de salidas)
+    return (getExits(x, y, false) & TILE_INTERSECTION) != 0;
 }
 
 bool Map::eatDot(int x, int y) {
     if (x < 0 || x >= MAP_WIDTH || y < 0 || y >= MAP_HEIGHT)
         return false;
     
-    if (tiles[y][x] == TileType::Dot) {
-        tiles[y][x] = TileType::Empty;
+    uint32_t bit = 1u << x;
+    if (layers.dots[y] & bit) {
+        layers.dots[y] &= ~bit;
         remainingDots--;
+        dotHash ^= dotKey(x, y);
         return true;
     }
     return false;
@@ -148,18 +294,57 @@ bool Map::eatPowerPellet(int x, int y) {
     if (x < 0 || x >= MAP_WIDTH || y < 0 || y >= MAP_HEIGHT)
         return false;
     
-    if (tiles[y][x] == TileType::PowerPellet) {
-        tiles[y][x] = TileType::Empty;
+    uint32_t bit = 1u << x;
+    if (layers.pellets[y] & bit) {
+        layers.pellets[y] &= ~bit;
         remainingDots--;
+        dotHash ^= pelletKey(x, y);
         return true;
     }
     return false;
 }
 
-int Map::getRemainingDots() const {
-    return remainingDots;
+int Map::countDots() const {
+    // Popcount de las capas de dots y pellets
+    int count = 0;
+    for (int y = 0; y < MAP_HEIGHT; y++) {
+        count += popcount32(layers.dots[y] | layers.pellets[y]);
+    }
+    return count;
+}
+
+uint64_t Map::computeDotHash() const {
+    uint64_t hash = 0;
+    forEachDot([&hash](int x, int y) { hash ^= dotKey(x, y); });
+    forEachPowerPellet([&hash](int x, int y) { hash ^= pelletKey(x, y); });
+    return hash;
+}
+
+void Map::setDotLayers(const uint32_t (&dots)[MAP_HEIGHT], const uint32_t (&pellets)[MAP_HEIGHT],
+                       int remaining, uint64_t hash) {
+    for (int y = 0; y < MAP_HEIGHT; y++) {
+        layers.dots[y] = dots[y];
+        layers.pellets[y] = pellets[y];
+    }
+    // La cuenta viene guardada: recontar costaría un popcount por fila
+    remainingDots = remaining;
+    dotHash = hash;
 }
 
 void Map::resetLevel() {
-    loadMap();
-}
\ No newline at end of file
+    // Paredes, puerta y túnel solo cambian con setTile: si siguen siendo los
+    // originales, las salidas, el flow field y las distancias siguen valiendo
+    const MapLayers& initial = initialLayers();
+    bool mazeChanged = std::memcmp(layers.walls, initial.walls, sizeof(layers.walls)) != 0 ||
+                       std::memcmp(layers.door, initial.door, sizeof(layers.door)) != 0 ||
+                       std::memcmp(layers.tunnel, initial.tunnel, sizeof(layers.tunnel)) != 0;
+    
+    layers = initial;
+    remainingDots = countDots();
+    dotHash = computeDotHash();
+    
+    if (mazeChanged) {
+        buildExitTables();
+        distances = originalDistances(*this);
+    }
+}
@@ -3,6 +3,12 @@
 #pragma once
 
 #include "Constants.h"
+#include "Bits.h"
+#include "Direction.h"
+#include "MazeDistances.h"
+#include "Zobrist.h"
+#include <cstdint>
+#include <memory>
 
 enum class TileType {
     Empty,
@@ -13,10 +19,33 @@ enum class TileType {
     Tunnel
 };
 
+// Bitboards del laberinto: una máscara de 32 bits por fila y por capa.
+// El bit x de la fila y corresponde al tile (x, y); 28 columnas caben en 32 bits.
+struct MapLayers {
+    uint32_t walls[MAP_HEIGHT];
+    uint32_t dots[MAP_HEIGHT];
+    uint32_t pellets[MAP_HEIGHT];
+    uint32_t door[MAP_HEIGHT];
+    uint32_t tunnel[MAP_HEIGHT];
+};
+
+// Bits de la tabla de salidas por tile (ver Map::getExits)
+enum ExitBits : uint8_t {
+    EXIT_UP    = 1,   // Igual a directionBit(Direction::Up)
+    EXIT_DOWN  = 2,
+    EXIT_LEFT  = 4,
+    EXIT_RIGHT = 8,
+    EXIT_MASK  = 15,
+    TILE_TUNNEL       = 16,
+    TILE_INTERSECTION = 32,  // Más de 2 salidas para Pac-Man
+    TILE_DECISION     = 64   // Más de 2 salidas con la máscara de esta tabla
+};
+
+// Cada partida (GameCore) tiene su propio mapa: no hay estado global,
+// así se pueden simular varias partidas en paralelo
 class Map {
 public:
-    // Singleton
-    static Map& get();
+    Map();
     
     // Acceso a tiles
     TileType getTile(int x, int y) const;
@@ -27,20 +56,98 @@ public:
     bool isTunnel(int x, int y) const;
     bool isIntersection(int x, int y) const;
     
+    // Salidas precalculadas: 4 bits de dirección + flags de túnel/intersección.
+    // Válido para x en [-1, MAP_WIDTH] e y en [-1, MAP_HEIGHT] (borde centinela),
+    // que cubre todos los tiles que pueden ocupar las entidades.
+    uint8_t getExits(int x, int y, bool isGhost) const {
+        return isGhost ? ghostExits[y + 1][x + 1] : pacmanExits[y + 1][x + 1];
+    }
+    bool canExit(int x, int y, Direction dir, bool isGhost) const {
+        return (getExits(x, y, isGhost) & directionBit(dir)) != 0;
+    }
+    
     // Dots
     bool eatDot(int x, int y);
     bool eatPowerPellet(int x, int y);
-    int getRemainingDots() const;
+    int getRemainingDots() const { return remainingDots; }
     int getTotalDots() const { return totalDots; }
     
-    // Reset
-    void resetLevel();
+    // Hash de Zobrist de los dots y pellets que quedan (se actualiza al comer)
+    uint64_t getDotHash() const { return dotHash; }
+    
+    // Reemplaza los dots y pellets que quedan (restaurar un GameSnapshot)
+    void setDotLayers(const uint32_t (&dots)[MAP_HEIGHT], const uint32_t (&pellets)[MAP_HEIGHT],
+                      int remaining, uint64_t hash);
+    
+    // Recorre solo los dots/pellets que quedan: fn(x, y)
+    template <typename Fn> void forEachDot(Fn&& fn) const { forEachBit(layers.dots, fn); }
+    template <typename Fn> void forEachPowerPellet(Fn&& fn) const { forEachBit(layers.pellets, fn); }
+    
+    const MapLayers& getLayers() const { return layers; }
+    
+    // Distancia de camino en tiles entre dos tiles caminables (-1 si no hay camino)
+    int getPathDistance(int x1, int y1, int x2, int y2) const;
+    // Primer paso del camino más corto de (x1, y1) a (x2, y2) (None si no hay)
+    Direction getNextHop(int x1, int y1, int x2, int y2) const;
+    const MazeDistances& getDistances() const { return *distances; }
+    
+    // Flow field hacia la casa (modo Eyes): dirección del camino más corto
+    // hasta el tile sobre la puerta. None en esos tiles o si no hay camino.
+    Direction getHomeDirection(int x, int y) const {
+        if (x < 0) x += MAP_WIDTH;
+        if (x >= MAP_WIDTH) x -= MAP_WIDTH;
+        if (x < 0 || x >= MAP_WIDTH || y < 0 || y >= MAP_HEIGHT)
+            return Direction::None;
+        return static_cast<Direction>(homeFlow[y][x]);
+    }
     
+    // Reset (copia las capas del laberinto original; si setTile cambió paredes,
+    // puerta o túnel, vuelve a armar las tablas)
+    void resetLevel();
+
 private:
-    Map();
-    void loadMap();
+    // Capas del laberinto original, parseadas una sola vez
+    static const MapLayers& initialLayers();
+    
+    template <typename Fn>
+    static void forEachBit(const uint32_t (&rows)[MAP_HEIGHT], Fn& fn) {
+        for (int y = 0; y < MAP_HEIGHT; y++) {
+            uint32_t bits = rows[y];
+            while (bits) {
+                fn(lowestBit32(bits), y);
+                bits &= bits - 1;
+            }
+        }
+    }
+    
+    // Recalcula las tablas de salidas y el flow field (al crear el mapa o cambiar un tile)
+    void buildExitTables();
+    uint8_t computeExits(int x, int y, bool isGhost) const;  // Solo bits de dirección
+    void buildHomeFlow();
+    
+    // Popcount de las capas (se usa al resetear; luego eatDot lleva la cuenta)
+    int countDots() const;
+    uint64_t computeDotHash() const;
+    
+    static uint64_t dotKey(int x, int y) {
+        return zobristKey(ZobristDomain::Dot, static_cast<uint64_t>(y * MAP_WIDTH + x));
+    }
+    static uint64_t pelletKey(int x, int y) {
+        return zobristKey(ZobristDomain::Pellet, static_cast<uint64_t>(y * MAP_WIDTH + x));
+    }
+    
+    MapLayers layers = {};
+    
+    // Tablas de salidas con borde centinela de 1 tile
+    uint8_t pacmanExits[MAP_HEIGHT + 2][MAP_WIDTH + 2];
+    uint8_t ghostExits[MAP_HEIGHT + 2][MAP_WIDTH + 2];  // Puede cruzar la puerta
+    
+    uint8_t homeFlow[MAP_HEIGHT][MAP_WIDTH];  // Direction por tile
+    
+    // Tabla de distancias compartida entre mapas con el mismo laberinto
+    std::shared_ptr<const MazeDistances> distances;
     
-    TileType tiles[MAP_HEIGHT][MAP_WIDTH];
     int totalDots = 0;
     int remainingDots = 0;
+    uint64_t dotHash = 0;
 };
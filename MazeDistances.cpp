@@ -0,0 +1,96 @@
+// MazeDistances.cpp
+#include "MazeDistances.h"
+#include "Map.h"
+
+// Prioridad del arcade para desempates: Up, Left, Down, Right
+static const Direction HOP_PRIORITY[] = {Direction::Up, Direction::Left, Direction::Down, Direction::Right};
+
+static void neighborTile(int x, int y, Direction d, int& nx, int& ny) {
+    nx = x;
+    ny = y;
+    switch (d) {
+        case Direction::Up:    ny--; break;
+        case Direction::Down:  ny++; break;
+        case Direction::Left:  nx--; break;
+        case Direction::Right: nx++; break;
+        default: break;
+    }
+    
+    // Wrap horizontal para túneles
+    if (nx < 0) nx += MAP_WIDTH;
+    if (nx >= MAP_WIDTH) nx -= MAP_WIDTH;
+}
+
+MazeDistances::MazeDistances(const Map& map) {
+    // Índices compactos de los tiles caminables
+    std::vector<int> tileX;
+    std::vector<int> tileY;
+    
+    for (int y = 0; y < MAP_HEIGHT; y++) {
+        for (int x = 0; x < MAP_WIDTH; x++) {
+            if (map.isWalkable(x, y, false)) {
+                tileIndex[y][x] = static_cast<int16_t>(tileCount++);
+                tileX.push_back(x);
+                tileY.push_back(y);
+            } else {
+                tileIndex[y][x] = -1;
+            }
+        }
+    }
+    
+    // Vecinos de cada tile según la tabla de salidas de Pac-Man
+    std::vector<int> neighbors(tileCount * 4, -1);
+    for (int i = 0; i < tileCount; i++) {
+        uint8_t exits = map.getExits(tileX[i], tileY[i], false);
+        for (int k = 0; k < 4; k++) {
+            Direction d = HOP_PRIORITY[k];
+            if (exits & directionBit(d)) {
+                int nx, ny;
+                neighborTile(tileX[i], tileY[i], d, nx, ny);
+                neighbors[i * 4 + k] = tileIndex[ny][nx];
+            }
+        }
+    }
+    
+    dist.assign(static_cast<size_t>(tileCount) * tileCount, UNREACHABLE);
+    hop.assign(static_cast<size_t>(tileCount) * tileCount, static_cast<uint8_t>(Direction::None));
+    
+    // BFS desde cada tile: como el grafo es simétrico, dist[t][*] sirve en ambos sentidos
+    std::vector<int> queue(tileCount);
+    for (int target = 0; target < tileCount; target++) {
+        uint16_t* row = &dist[static_cast<size_t>(target) * tileCount];
+        int head = 0;
+        int tail = 0;
+        
+        row[target] = 0;
+        queue[tail++] = target;
+        
+        while (head < tail) {
+            int cur = queue[head++];
+            for (int k = 0; k < 4; k++) {
+                int n = neighbors[cur * 4 + k];
+                if (n >= 0 && row[n] == UNREACHABLE) {
+                    row[n] = row[cur] + 1;
+                    queue[tail++] = n;
+                }
+            }
+        }
+    }
+    
+    // Primer paso: el vecino que acerca al destino (desempate por prioridad del arcade)
+    for (int from = 0; from < tileCount; from++) {
+        for (int to = 0; to < tileCount; to++) {
+            uint16_t d = distance(to, from);
+            if (d == 0 || d == UNREACHABLE)
+                continue;
+            
+            for (int k = 0; k < 4; k++) {
+                int n = neighbors[from * 4 + k];
+                if (n >= 0 && distance(to, n) == d - 1) {
+                    hop[static_cast<size_t>(from) * tileCount + to] = static_cast<uint8_t>(HOP_PRIORITY[k]);
+                    break;
+                }
+            }
+        }
+    }
+}
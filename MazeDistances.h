@@ -0,0 +1,43 @@
+// MazeDistances.h
+// Distancias de camino entre todos los pares de tiles caminables (BFS)
+#pragma once
+
+#include "Constants.h"
+#include "Direction.h"
+#include <cstdint>
+#include <vector>
+
+class Map;
+
+// Tabla compacta: distancia en tiles (16 bits) y primer paso (dirección)
+// para cada par de tiles caminables por Pac-Man. Es inmutable una vez
+// construida, así que todas las partidas con el mismo laberinto la comparten.
+class MazeDistances {
+public:
+    static constexpr uint16_t UNREACHABLE = 0xFFFF;
+    
+    explicit MazeDistances(const Map& map);
+    
+    // Índice compacto del tile (con wrap horizontal) o -1 si no es caminable
+    int getTileIndex(int x, int y) const {
+        if (x < 0) x += MAP_WIDTH;
+        if (x >= MAP_WIDTH) x -= MAP_WIDTH;
+        if (x < 0 || x >= MAP_WIDTH || y < 0 || y >= MAP_HEIGHT)
+            return -1;
+        return tileIndex[y][x];
+    }
+    
+    int getTileCount() const { return tileCount; }
+    
+    // Distancia en tiles (UNREACHABLE si no hay camino)
+    uint16_t distance(int from, int to) const { return dist[from * tileCount + to]; }
+    
+    // Primera dirección a tomar desde 'from' hacia 'to' (None si from == to o no hay camino)
+    Direction nextHop(int from, int to) const { return static_cast<Direction>(hop[from * tileCount + to]); }
+
+private:
+    int tileCount = 0;
+    int16_t tileIndex[MAP_HEIGHT][MAP_WIDTH];
+    std::vector<uint16_t> dist;
+    std::vector<uint8_t> hop;
+};
@@ -0,0 +1,147 @@
+// MetricsServer.cpp
+#include "MetricsServer.h"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+#ifdef _WIN32
+
+bool MetricsServer::start(const std::string&, Provider) {
+    return false;
+}
+
+void MetricsServer::stop() {
+}
+
+void MetricsServer::serveLoop() {
+}
+
+void MetricsServer::serveClient(int) {
+}
+
+#else
+
+// El hilo revisa 'stopping' cada POLL_MS
+static constexpr int POLL_MS = 200;
+
+// macOS no tiene MSG_NOSIGNAL: se usa SO_NOSIGPIPE en el socket del cliente
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+bool MetricsServer::start(const std::string& path, Provider p) {
+    if (listenFd >= 0)
+        return false;
+    
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path))
+        return false;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return false;
+    
+    // Un socket de una ejecución anterior bloquearía el bind. Solo se borra
+    // si es un socket: cualquier otro archivo en 'path' hace fallar start()
+    struct stat info;
+    if (lstat(path.c_str(), &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            close(fd);
+            return false;
+        }
+        unlink(path.c_str());
+    }
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(fd, 4) != 0) {
+        close(fd);
+        return false;
+    }
+    
+    socketPath = path;
+    provider = std::move(p);
+    listenFd = fd;
+    stopping = false;
+    thread = std::thread(&MetricsServer::serveLoop, this);
+    return true;
+}
+
+void MetricsServer::stop() {
+    if (listenFd < 0)
+        return;
+    
+    stopping = true;
+    if (thread.joinable()) thread.join();
+    close(listenFd);
+    unlink(socketPath.c_str());
+    listenFd = -1;
+}
+
+void MetricsServer::serveLoop() {
+    while (!stopping) {
+        pollfd pfd = {listenFd, POLLIN, 0};
+        int ready = poll(&pfd, 1, POLL_MS);
+        if (ready <= 0)
+            continue;
+        
+        int client = accept(listenFd, nullptr, nullptr);
+        if (client < 0)
+            continue;
+#ifdef SO_NOSIGPIPE
+        int one = 1;
+        setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+        serveClient(client);
+        close(client);
+    }
+}
+
+void MetricsServer::serveClient(int fd) {
+    // Leer hasta el fin de los headers (o una línea, o lo que llegue en POLL_MS)
+    char request[1024];
+    size_t received = 0;
+    while (received < sizeof(request) - 1) {
+        pollfd pfd = {fd, POLLIN, 0};
+        if (poll(&pfd, 1, POLL_MS) <= 0)
+            break;
+        ssize_t n = recv(fd, request + received, sizeof(request) - 1 - received, 0);
+        if (n <= 0)
+            break;
+        received += static_cast<size_t>(n);
+        request[received] = '\0';
+        if (std::strstr(request, "\r\n\r\n") || (std::strncmp(request, "GET ", 4) != 0 && std::strchr(request, '\n')))
+            break;
+    }
+    
+    std::string body;
+    provider(body);
+    
+    std::string response = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: ";
+    response += std::to_string(body.size());
+    response += "\r\nConnection: close\r\n\r\n";
+    response += body;
+    
+    size_t sent = 0;
+    while (sent < response.size()) {
+        ssize_t n = send(fd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+        sent += static_cast<size_t>(n);
+    }
+}
+
+#endif
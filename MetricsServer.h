@@ -0,0 +1,39 @@
+// MetricsServer.h
+// Endpoint local de métricas (texto de Prometheus) en un socket Unix
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+
+// Un hilo propio acepta conexiones en 'path', lee el pedido (HTTP o
+// cualquier línea) y responde con el texto que arma 'provider' como
+// HTTP/1.0 200. El provider corre en el hilo del servidor: debe leer
+// solo datos seguros entre hilos (p. ej. FrameStats).
+// En Windows no hay endpoint: start() devuelve false.
+class MetricsServer {
+public:
+    using Provider = std::function<void(std::string& out)>;
+    
+    MetricsServer() = default;
+    ~MetricsServer();
+    
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+    
+    // Crea el socket (reemplaza un socket viejo en 'path'; si hay otro tipo
+    // de archivo devuelve false) y arranca el hilo
+    bool start(const std::string& path, Provider provider);
+    void stop();
+
+private:
+    std::string socketPath;
+    Provider provider;
+    int listenFd = -1;
+    std::thread thread;
+    std::atomic<bool> stopping{false};
+    
+    void serveLoop();
+    void serveClient(int fd);
+};
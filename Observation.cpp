@@ -0,0 +1,109 @@
+// Observation.cpp
+#include "Observation.h"
+#include "Bits.h"
+#include <algorithm>
+
+static int cellIndex(int tileX, int tileY) {
+    if (tileX < 0 || tileX >= MAP_WIDTH || tileY < 0 || tileY >= MAP_HEIGHT)
+        return -1;
+    return tileY * MAP_WIDTH + tileX;
+}
+
+static int ghostChannel(int index, GhostMode mode) {
+    switch (mode) {
+        case GhostMode::Frightened: return OBS_FRIGHTENED;
+        case GhostMode::Eyes:       return OBS_EYES;
+        default:                    return OBS_GHOST_FIRST + index;
+    }
+}
+
+template <typename T>
+void ObservationEncoder<T>::attach(T* out, const GameCore& core) {
+    buffer = out;
+    std::fill(buffer, buffer + SIZE, T(0));
+    
+    // Paredes (y puerta): no cambian durante la partida
+    const MapLayers& layers = core.getMap().getLayers();
+    for (int y = 0; y < MAP_HEIGHT; y++) {
+        uint32_t bits = layers.walls[y] | layers.door[y];
+        while (bits) {
+            set(cellIndex(lowestBit32(bits), y), OBS_WALLS, true);
+            bits &= bits - 1;
+        }
+    }
+    
+    // Partir de "nada escrito" para que update() llene el resto
+    std::fill(dots, dots + MAP_HEIGHT, 0u);
+    std::fill(pellets, pellets + MAP_HEIGHT, 0u);
+    std::fill(cell, cell + ENTITIES, -1);
+    fruit = false;
+    
+    update(core);
+}
+
+template <typename T>
+void ObservationEncoder<T>::update(const GameCore& core) {
+    // Dots y pellets: solo los bits que cambiaron
+    const MapLayers& layers = core.getMap().getLayers();
+    for (int y = 0; y < MAP_HEIGHT; y++) {
+        uint32_t changed = dots[y] ^ layers.dots[y];
+        while (changed) {
+            int x = lowestBit32(changed);
+            set(y * MAP_WIDTH + x, OBS_DOTS, (layers.dots[y] >> x) & 1u);
+            changed &= changed - 1;
+        }
+        dots[y] = layers.dots[y];
+        
+        changed = pellets[y] ^ layers.pellets[y];
+        while (changed) {
+            int x = lowestBit32(changed);
+            set(y * MAP_WIDTH + x, OBS_PELLETS, (layers.pellets[y] >> x) & 1u);
+            changed &= changed - 1;
+        }
+        pellets[y] = layers.pellets[y];
+    }
+    
+    // Entidades: borrar la celda anterior y marcar la nueva
+    const PacMan& pacman = core.getPacman();
+    updateEntity(0, pacman.getTileX(), pacman.getTileY(), OBS_PACMAN);
+    
+    const std::vector<Ghost>& ghosts = core.getGhosts();
+    for (int i = 0; i < GhostPersonalities::count; i++) {
+        const Ghost& g = ghosts[i];
+        updateEntity(i + 1, g.getTileX(), g.getTileY(), ghostChannel(i, g.getMode()));
+    }
+    
+    // Fruta
+    bool visible = core.isFruitVisible();
+    if (visible != fruit) {
+        set(cellIndex(FRUIT_TILE_X, FRUIT_TILE_Y), OBS_FRUIT, visible);
+        fruit = visible;
+    }
+}
+
+template <typename T>
+void ObservationEncoder<T>::updateEntity(int entity, int tileX, int tileY, int ch) {
+    int c = cellIndex(tileX, tileY);
+    if (c == cell[entity] && ch == channel[entity])
+        return;
+    
+    // Varios fantasmas pueden compartir celda y canal (asustados, ojos):
+    // la celda vieja solo se apaga si nadie más la ocupa con ese canal
+    if (cell[entity] >= 0) {
+        bool shared = false;
+        for (int e = 0; e < ENTITIES; e++) {
+            if (e != entity && cell[e] == cell[entity] && channel[e] == channel[entity]) {
+                shared = true;
+                break;
+            }
+        }
+        if (!shared) set(cell[entity], channel[entity], false);
+    }
+    
+    if (c >= 0) set(c, ch, true);
+    cell[entity] = c;
+    channel[entity] = ch;
+}
+
+template class ObservationEncoder<uint8_t>;
+template class ObservationEncoder<float>;
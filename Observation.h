@@ -0,0 +1,63 @@
+// Observation.h
+// Estado de la partida como tensor denso (para agentes y análisis)
+#pragma once
+
+#include "GameCore.h"
+#include "GhostPersonality.h"
+#include "Constants.h"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Canales de la observación (un plano de MAP_WIDTH x MAP_HEIGHT por canal)
+enum ObservationChannel : int {
+    OBS_WALLS = 0,
+    OBS_DOTS,
+    OBS_PELLETS,
+    OBS_PACMAN,
+    OBS_GHOST_FIRST,                                          // Un canal por fantasma (Scatter/Chase)
+    OBS_FRIGHTENED = OBS_GHOST_FIRST + GhostPersonalities::count,  // Fantasmas asustados
+    OBS_EYES,                                                 // Ojos volviendo a casa
+    OBS_FRUIT,
+    OBS_CHANNELS
+};
+
+// Escribe la observación en un buffer del llamador, canales al final:
+// buffer[(y * MAP_WIDTH + x) * OBS_CHANNELS + canal] = 1 o 0.
+// attach() llena el buffer completo una vez; después update() solo toca
+// las celdas que cambiaron: XOR de los bitboards de dots/pellets contra los
+// del último update y las celdas anteriores y nuevas de cada entidad.
+// Sirve también después de GameCore::restore (el diff cubre cualquier salto).
+template <typename T>
+class ObservationEncoder {
+    static_assert(std::is_same<T, uint8_t>::value || std::is_same<T, float>::value,
+                  "Observaciones en uint8_t o float");
+
+public:
+    static constexpr size_t SIZE = static_cast<size_t>(MAP_WIDTH) * MAP_HEIGHT * OBS_CHANNELS;
+    
+    void attach(T* buffer, const GameCore& core);
+    void update(const GameCore& core);
+    
+    T* getBuffer() const { return buffer; }
+
+private:
+    static constexpr int ENTITIES = 1 + GhostPersonalities::count;
+    
+    T* buffer = nullptr;
+    
+    // Lo último que se escribió
+    uint32_t dots[MAP_HEIGHT] = {};
+    uint32_t pellets[MAP_HEIGHT] = {};
+    int cell[ENTITIES] = {};      // Índice de celda (-1 = fuera del mapa, p. ej. en el túnel)
+    int channel[ENTITIES] = {};
+    bool fruit = false;
+    
+    void set(int cellIndex, int ch, bool on) {
+        buffer[static_cast<size_t>(cellIndex) * OBS_CHANNELS + ch] = on ? T(1) : T(0);
+    }
+    void updateEntity(int entity, int tileX, int tileY, int ch);
+};
+
+extern template class ObservationEncoder<uint8_t>;
+extern template class ObservationEncoder<float>;
@@ -7,25 +7,20 @@ PacMan::PacMan() {
     reset();
 }
 
-void PacMan::reset() {
+void PacMan::onReset() {
     // Posición inicial (centro de tile, escalada)
-    position.x = PACMAN_START_X * TILE_SIZE * SCALE;
-    position.y = PACMAN_START_Y * TILE_SIZE * SCALE;
+    setPosition(tileToFixed(PACMAN_START_X), tileToFixed(PACMAN_START_Y));
     
     direction = Direction::Left;
     desiredDirection = Direction::Left;
     speed = PACMAN_SPEED;
-    speedMultiplier = 1.0f;
+    speedPercent = 100;
     
     alive = true;
     eating = false;
     dying = false;
     deathAnimComplete = false;
     
-    ateDot = false;
-    atePowerPellet = false;
-    ateFruit = false;
-    
     animTimer = 0.0f;
     animFrame = 0;
     deathTimer = 0.0f;
@@ -36,81 +31,31 @@ void PacMan::setDesiredDirection(Direction dir) {
     desiredDirection = dir;
 }
 
-bool PacMan::canMove(Direction dir) const {
-    int tx = getTileX();
-    int ty = getTileY();
-    
-    switch (dir) {
-        case Direction::Up:    ty--; break;
-        case Direction::Down:  ty++; break;
-        case Direction::Left:  tx--; break;
-        case Direction::Right: tx++; break;
-        default: return false;
-    }
-    
-    return Map::get().isWalkable(tx, ty, false);
-}
-
-void PacMan::handleTunnelWrap() {
-    // Túnel izquierdo
-    if (position.x < -SCALED_TILE) {
-        position.x = MAP_WIDTH * SCALED_TILE;
-    }
-    // Túnel derecho
-    else if (position.x > MAP_WIDTH * SCALED_TILE) {
-        position.x = -SCALED_TILE;
-    }
+bool PacMan::canMove(const Map& map, Direction dir) const {
+    return map.canExit(getTileX(), getTileY(), dir, false);
 }
 
-void PacMan::update(float dt) {
+void PacMan::onUpdate(float dt, Map& map) {
     if (!alive || dying)
         return;
     
-    // Reset eventos
-    ateDot = false;
-    atePowerPellet = false;
-    ateFruit = false;
-    eating = false;
-    
     // Solo cambiar dirección cuando está centrado en un tile
     if (isCentered()) {
         // Intentar cambiar a la dirección deseada
-        if (canMove(desiredDirection)) {
+        if (canMove(map, desiredDirection)) {
             direction = desiredDirection;
         }
         // Si no puede continuar en la dirección actual, detenerse
-        else if (!canMove(direction)) {
+        else if (!canMove(map, direction)) {
             direction = Direction::None;
         }
-        
-        // Comer dot o power pellet
-        int tx = getTileX();
-        int ty = getTileY();
-        
-        if (Map::get().eatDot(tx, ty)) {
-            ateDot = true;
-            eating = true;
-            // El sonido waka se maneja en Game.cpp
-        }
-        else if (Map::get().eatPowerPellet(tx, ty)) {
-            atePowerPellet = true;
-            eating = true;
-        }
     }
     
     // Movimiento
     if (direction != Direction::None) {
-        float moveSpeed = eating ? PACMAN_DOT_SPEED : speed;
-        moveSpeed *= speedMultiplier;  // Aplicar multiplicador de nivel
-        float move = moveSpeed * dt;
-        
-        switch (direction) {
-            case Direction::Up:    position.y -= move; break;
-            case Direction::Down:  position.y += move; break;
-            case Direction::Left:  position.x -= move; break;
-            case Direction::Right: position.x += move; break;
-            default: break;
-        }
+        int moveSpeed = eating ? PACMAN_DOT_SPEED : speed;
+        moveSpeed = moveSpeed * speedPercent / 100;  // Aplicar multiplicador de nivel
+        moveBy(direction, moveSpeed);
         
         // Animación waka-waka (solo si se mueve)
         animTimer += dt;
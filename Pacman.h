@@ -6,25 +6,19 @@
 #include "Direction.h"
 #include <string>
 
-class PacMan : public Entity {
+class PacMan : public Entity<PacMan> {
 public:
     PacMan();
     
-    void update(float dt) override;
-    void reset() override;
-    
     // Control
     void setDesiredDirection(Direction dir);
-    void setSpeedMultiplier(float mult) { speedMultiplier = mult; }
+    Direction getDesiredDirection() const { return desiredDirection; }
+    void setSpeedPercent(int percent) { speedPercent = percent; }  // Multiplicador de nivel (100 = base)
     
     // Estado
     bool isAlive() const { return alive; }
     bool isEating() const { return eating; }
-    
-    // Eventos del último frame
-    bool ateDot = false;
-    bool atePowerPellet = false;
-    bool ateFruit = false;
+    void setEating(bool e) { eating = e; }  // Lo decide GameCore al comer en el tile actual
     
     // Animación de muerte
     void die();
@@ -34,10 +28,10 @@ public:
     
     // Obtener frame de animación actual
     int getAnimFrame() const { return animFrame; }
-    
+
 private:
     Direction desiredDirection = Direction::Left;
-    float speedMultiplier = 1.0f;
+    int speedPercent = 100;
     
     bool alive = true;
     bool eating = false;
@@ -53,6 +47,10 @@ private:
     int deathFrame = 0;
     
     // Movimiento
-    bool canMove(Direction dir) const;
-    void handleTunnelWrap();
+    bool canMove(const Map& map, Direction dir) const;
+    
+    // Implementación de Entity (CRTP)
+    friend class Entity<PacMan>;
+    void onUpdate(float dt, Map& map);
+    void onReset();
 };
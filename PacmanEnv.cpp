@@ -0,0 +1,162 @@
+// PacmanEnv.cpp
+#include "PacmanEnv.h"
+#include "GameCore.h"
+#include "GameSnapshot.h"
+#include "WorkerPool.h"
+#include "Observation.h"
+#include "Constants.h"
+#include <memory>
+#include <vector>
+
+// Tope de ticks para atravesar una pausa (Ready dura ~2 s, la muerte ~3 s)
+static constexpr int MAX_SKIP_TICKS = 1200;
+
+struct pacman_env {
+    int frameSkip = 1;
+    std::vector<std::unique_ptr<GameCore>> games;
+    std::vector<uint32_t> seeds;
+    WorkerPool pool;
+    
+    // Partida recién empezada, ya en Playing: reset = restore + semilla
+    GameSnapshot fresh;
+    
+    // Observaciones en buffers del llamador (a lo sumo uno de los dos)
+    std::vector<ObservationEncoder<uint8_t>> obsU8;
+    std::vector<ObservationEncoder<float>> obsF32;
+    
+    pacman_env(int numEnvs, int numThreads, int skip) : frameSkip(skip), pool(numThreads) {
+        GameCore start;
+        start.startGame();
+        start.newGame();
+        while (start.getState() != GameState::Playing) {
+            start.update();
+        }
+        start.save(fresh);
+        
+        // Cada GameCore arma su mapa: también se reparte entre los hilos
+        games.resize(numEnvs);
+        seeds.assign(numEnvs, GameRandom::DEFAULT_SEED);
+        forEachGame([this](int i) {
+            games[i].reset(new GameCore());
+            resetGame(i);
+        });
+    }
+    
+    void resetGame(int i) {
+        games[i]->restore(fresh);
+        games[i]->setSeed(seeds[i]);
+        games[i]->getEvents().clear();
+    }
+    
+    void updateObservation(int i) {
+        if (!obsU8.empty()) obsU8[i].update(*games[i]);
+        if (!obsF32.empty()) obsF32[i].update(*games[i]);
+    }
+    
+    // Cada worker avanza un bloque contiguo de partidas
+    template <typename Fn>
+    void forEachGame(Fn&& fn) {
+        int n = static_cast<int>(games.size());
+        int workers = pool.size();
+        pool.run([&](int w) {
+            int begin = static_cast<int>(static_cast<long long>(n) * w / workers);
+            int end = static_cast<int>(static_cast<long long>(n) * (w + 1) / workers);
+            for (int i = begin; i < end; i++) fn(i);
+        });
+    }
+};
+
+// Un step de una partida; devuelve true si terminó
+static bool stepGame(GameCore& core, int32_t action, int frameSkip, float& reward) {
+    if (action >= PACMAN_ACTION_UP && action <= PACMAN_ACTION_RIGHT) {
+        core.setDesiredDirection(static_cast<Direction>(action));
+    }
+    
+    int scoreBefore = core.getScore();
+    
+    for (int t = 0; t < frameSkip; t++) {
+        core.update();
+    }
+    
+    // Saltear las pausas para que el agente solo vea estados jugables
+    for (int t = 0; t < MAX_SKIP_TICKS; t++) {
+        GameState state = core.getState();
+        if (state == GameState::Playing || state == GameState::GameOver)
+            break;
+        core.update();
+    }
+    
+    // Nadie consume los eventos
+    core.getEvents().clear();
+    
+    reward = static_cast<float>(core.getScore() - scoreBefore);
+    return core.getState() == GameState::GameOver;
+}
+
+// Asocia un encoder por partida a su tramo del buffer y lo llena
+template <typename T>
+static void attachObservations(pacman_env* env, std::vector<ObservationEncoder<T>>& encoders, T* buffer) {
+    env->obsU8.clear();
+    env->obsF32.clear();
+    if (!buffer)
+        return;
+    
+    encoders.resize(env->games.size());
+    env->forEachGame([&](int i) {
+        encoders[i].attach(buffer + i * ObservationEncoder<T>::SIZE, *env->games[i]);
+    });
+}
+
+extern "C" {
+
+pacman_env* pacman_env_create(int num_envs, int num_threads, int frame_skip) {
+    if (num_envs <= 0 || num_threads < 0 || frame_skip <= 0)
+        return nullptr;
+    
+    return new pacman_env(num_envs, num_threads, frame_skip);
+}
+
+void pacman_env_destroy(pacman_env* env) {
+    delete env;
+}
+
+int pacman_env_num_envs(const pacman_env* env) {
+    return static_cast<int>(env->games.size());
+}
+
+void pacman_env_reset(pacman_env* env, const uint32_t* seeds) {
+    if (seeds) {
+        env->seeds.assign(seeds, seeds + env->games.size());
+    }
+    env->forEachGame([env](int i) {
+        env->resetGame(i);
+        env->updateObservation(i);
+    });
+}
+
+void pacman_env_step(pacman_env* env, const int32_t* actions, float* rewards, uint8_t* dones) {
+    env->forEachGame([=](int i) {
+        bool done = stepGame(*env->games[i], actions[i], env->frameSkip, rewards[i]);
+        dones[i] = done ? 1 : 0;
+        if (done) env->resetGame(i);
+        env->updateObservation(i);
+    });
+}
+
+int pacman_env_observation_channels(void) {
+    return OBS_CHANNELS;
+}
+
+int pacman_env_observation_size(void) {
+    return static_cast<int>(ObservationEncoder<uint8_t>::SIZE);
+}
+
+void pacman_env_set_observation_u8(pacman_env* env, uint8_t* buffer) {
+    attachObservations(env, env->obsU8, buffer);
+}
+
+void pacman_env_set_observation_f32(pacman_env* env, float* buffer) {
+    attachObservations(env, env->obsF32, buffer);
+}
+
+}
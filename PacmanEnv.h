@@ -0,0 +1,68 @@
+/* PacmanEnv.h
+ * API en C para entrenar agentes: N partidas independientes que avanzan
+ * juntas en cada llamada (biblioteca compartida pacman_env). */
+#pragma once
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+    #if defined(PACMAN_ENV_BUILD)
+        #define PACMAN_ENV_API __declspec(dllexport)
+    #else
+        #define PACMAN_ENV_API __declspec(dllimport)
+    #endif
+#else
+    #define PACMAN_ENV_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct pacman_env pacman_env;
+
+/* Acciones: 0 = mantener la dirección deseada, 1-4 = arriba, abajo,
+ * izquierda, derecha (mismo orden que Direction) */
+enum {
+    PACMAN_ACTION_NOOP  = 0,
+    PACMAN_ACTION_UP    = 1,
+    PACMAN_ACTION_DOWN  = 2,
+    PACMAN_ACTION_LEFT  = 3,
+    PACMAN_ACTION_RIGHT = 4
+};
+
+/* num_threads = 0: un hilo por núcleo. frame_skip: ticks de simulación
+ * (1/60 s) por step; la acción se aplica en el primero. Devuelve NULL si
+ * los parámetros no son válidos. */
+PACMAN_ENV_API pacman_env* pacman_env_create(int num_envs, int num_threads, int frame_skip);
+PACMAN_ENV_API void pacman_env_destroy(pacman_env* env);
+
+PACMAN_ENV_API int pacman_env_num_envs(const pacman_env* env);
+
+/* Reinicia todas las partidas. seeds: num_envs semillas, o NULL para
+ * repetir la semilla anterior de cada una. Las partidas quedan en Playing. */
+PACMAN_ENV_API void pacman_env_reset(pacman_env* env, const uint32_t* seeds);
+
+/* Avanza todas las partidas. actions, rewards y dones tienen num_envs
+ * elementos (los buffers son del llamador). reward = puntos ganados en el
+ * step; done = 1 si terminó la partida (Game Over), y en ese caso se
+ * reinicia sola con su semilla. Las pausas (Ready, muerte, nivel
+ * completado) se saltean: cada step termina en Playing. */
+PACMAN_ENV_API void pacman_env_step(pacman_env* env, const int32_t* actions,
+                                    float* rewards, uint8_t* dones);
+
+/* Observaciones: por partida un tensor de 31 filas x 28 columnas x canales
+ * (canales al final; ver ObservationChannel en Observation.h), con 1 donde
+ * hay pared, dot, pellet, Pac-Man, cada fantasma según su modo o la fruta. */
+PACMAN_ENV_API int pacman_env_observation_channels(void);
+PACMAN_ENV_API int pacman_env_observation_size(void);  /* Elementos por partida */
+
+/* El buffer (num_envs * observation_size elementos, del llamador) se llena
+ * al asociarlo y después reset y step actualizan solo las celdas que
+ * cambiaron. NULL lo desasocia. Solo un formato a la vez. */
+PACMAN_ENV_API void pacman_env_set_observation_u8(pacman_env* env, uint8_t* buffer);
+PACMAN_ENV_API void pacman_env_set_observation_f32(pacman_env* env, float* buffer);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,123 @@
+// Profiler.cpp
+#include "Profiler.h"
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Profiler {
+
+struct ThreadBuffer {
+    std::string threadName;
+    uint32_t threadId;
+    std::vector<Event> events;
+    uint32_t mask;
+    uint64_t count = 0;  // Eventos grabados en total (el índice es count & mask)
+};
+
+// Registro de buffers (solo se toca al registrar y al exportar)
+static std::mutex registryMutex;
+static std::vector<std::unique_ptr<ThreadBuffer>> registry;
+
+static thread_local ThreadBuffer* threadBuffer = nullptr;
+
+static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+ThreadBuffer* current() {
+    return threadBuffer;
+}
+
+uint64_t now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch).count());
+}
+
+void registerThread(const char* threadName, uint32_t capacity) {
+    if (threadBuffer)
+        return;
+    
+    uint32_t size = 1;
+    while (size < capacity) size <<= 1;
+    
+    std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer());
+    buffer->threadName = threadName;
+    buffer->events.resize(size);
+    buffer->mask = size - 1;
+    
+    std::lock_guard<std::mutex> lock(registryMutex);
+    buffer->threadId = static_cast<uint32_t>(registry.size()) + 1;
+    threadBuffer = buffer.get();
+    registry.push_back(std::move(buffer));
+}
+
+void record(ThreadBuffer* buffer, const char* name, uint64_t start, uint64_t end) {
+    Event& e = buffer->events[buffer->count & buffer->mask];
+    e.name = name;
+    e.start = start;
+    e.duration = end - start;
+    buffer->count++;
+}
+
+// Los nombres de zona son literales del código: solo se escapan comillas y barras
+static void writeEscaped(std::ostream& out, const char* s) {
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') out << '\\';
+        out << *s;
+    }
+}
+
+bool dumpChromeTrace(const std::string& path, double seconds) {
+    std::ofstream file(path);
+    if (!file.is_open())
+        return false;
+    
+    uint64_t cutoff = 0;
+    uint64_t end = now();
+    uint64_t window = static_cast<uint64_t>(seconds * 1e9);
+    if (end > window) cutoff = end - window;
+    
+    std::lock_guard<std::mutex> lock(registryMutex);
+    
+    file << "{\"traceEvents\":[\n";
+    bool first = true;
+    char number[64];
+    
+    for (const std::unique_ptr<ThreadBuffer>& buffer : registry) {
+        // Nombre del hilo (metadato)
+        file << (first ? "" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":"
+             << buffer->threadId << ",\"args\":{\"name\":\"";
+        writeEscaped(file, buffer->threadName.c_str());
+        file << "\"}}";
+        first = false;
+        
+        uint64_t size = buffer->events.size();
+        uint64_t begin = buffer->count > size ? buffer->count - size : 0;
+        for (uint64_t i = begin; i < buffer->count; i++) {
+            const Event& e = buffer->events[i & buffer->mask];
+            if (e.start + e.duration < cutoff)
+                continue;
+            
+            // Evento completo ("X"): ts y dur en microsegundos
+            file << ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"name\":\"";
+            writeEscaped(file, e.name);
+            std::snprintf(number, sizeof(number), "\",\"ts\":%.3f,\"dur\":%.3f}",
+                          e.start / 1000.0, e.duration / 1000.0);
+            file << number;
+        }
+    }
+    
+    file << "\n]}\n";
+    return file.good();
+}
+
+Suspend::Suspend() : saved(threadBuffer) {
+    threadBuffer = nullptr;
+}
+
+Suspend::~Suspend() {
+    threadBuffer = saved;
+}
+
+}
@@ -0,0 +1,78 @@
+// Profiler.h
+// Zonas de tiempo por scope con export a Chrome trace (chrome://tracing, Perfetto)
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Solo graban los hilos registrados (registerThread), cada uno en su propio
+// buffer circular: sin locks al grabar. En los demás hilos (workers del
+// piloto automático, entornos) una zona cuesta una lectura thread_local.
+// Sin PACMAN_PROFILE las macros no generan código.
+namespace Profiler {
+    struct Event {
+        const char* name;   // Literal: no se copia
+        uint64_t start;     // ns desde el inicio del programa
+        uint64_t duration;  // ns
+    };
+    
+    struct ThreadBuffer;
+    
+    // Buffer del hilo actual (nullptr si no graba)
+    ThreadBuffer* current();
+    
+    // Empieza a grabar en este hilo (capacidad en eventos, se redondea a potencia de 2)
+    void registerThread(const char* threadName, uint32_t capacity = 1u << 16);
+    
+    uint64_t now();
+    void record(ThreadBuffer* buffer, const char* name, uint64_t start, uint64_t end);
+    
+    // Escribe los eventos de los últimos 'seconds' segundos de todos los
+    // hilos registrados. Llamar desde un hilo registrado con los demás quietos.
+    bool dumpChromeTrace(const std::string& path, double seconds);
+    
+    // Zona: mide desde la construcción hasta el fin del scope
+    class Zone {
+    public:
+        explicit Zone(const char* zoneName) : buffer(current()), name(zoneName) {
+            if (buffer) start = now();
+        }
+        ~Zone() {
+            if (buffer) record(buffer, name, start, now());
+        }
+        
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+    
+    private:
+        ThreadBuffer* buffer;
+        const char* name;
+        uint64_t start = 0;
+    };
+    
+    // Deja de grabar en este hilo mientras dure el scope (p. ej. los
+    // rollouts del piloto automático que corren en el hilo principal)
+    class Suspend {
+    public:
+        Suspend();
+        ~Suspend();
+        
+        Suspend(const Suspend&) = delete;
+        Suspend& operator=(const Suspend&) = delete;
+    
+    private:
+        ThreadBuffer* saved;
+    };
+}
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef PACMAN_PROFILE
+#define PROFILE_ZONE(name) Profiler::Zone PROFILE_CONCAT(profileZone_, __LINE__)(name)
+#define PROFILE_SUSPEND() Profiler::Suspend PROFILE_CONCAT(profileSuspend_, __LINE__)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_SUSPEND() ((void)0)
+#endif
@@ -3,6 +3,8 @@
 #include "TextureManager.h"
 #include "Map.h"
 #include "Constants.h"
+#include "Profiler.h"
+#include <cstring>
 #include <iostream>
 #include <string>
 
@@ -56,7 +58,29 @@ bool Renderer::init() {
     return true;
 }
 
+bool Renderer::initOffscreen() {
+    // El renderer por software no necesita ventana ni subsistema de video
+    target = SDL_CreateRGBSurfaceWithFormat(0, SCREEN_WIDTH, SCREEN_HEIGHT, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!target) {
+        std::cerr << "Offscreen surface creation failed: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    
+    renderer = SDL_CreateSoftwareRenderer(target);
+    if (!renderer) {
+        std::cerr << "Software renderer creation failed: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    
+    return true;
+}
+
 void Renderer::shutdown() {
+    destroyMazeCache();
+    destroyDotCache();
+    mazeCacheFailed = false;
+    dotCacheFailed = false;
+    
     if (font) {
         TTF_CloseFont(font);
         font = nullptr;
@@ -74,6 +98,11 @@ void Renderer::shutdown() {
         window = nullptr;
     }
     
+    if (target) {
+        SDL_FreeSurface(target);
+        target = nullptr;
+    }
+    
     TTF_Quit();
     SDL_Quit();
 }
@@ -84,19 +113,19 @@ void Renderer::clear() {
 }
 
 void Renderer::present() {
+    TextureManager::get().flush();
+    PROFILE_ZONE("SDL_RenderPresent");
     SDL_RenderPresent(renderer);
 }
 
-void Renderer::drawWallTile(int tileX, int tileY) {
-    SDL_SetRenderDrawColor(renderer, 33, 33, 222, 255);
-    
+void Renderer::drawWallTile(const Map& map, int tileX, int tileY, int offsetY) {
     int x = tileX * SCALED_TILE;
-    int y = tileY * SCALED_TILE + GAME_OFFSET_Y;
+    int y = tileY * SCALED_TILE + offsetY;
     
-    bool wallUp = Map::get().getTile(tileX, tileY - 1) == TileType::Wall;
-    bool wallDown = Map::get().getTile(tileX, tileY + 1) == TileType::Wall;
-    bool wallLeft = Map::get().getTile(tileX - 1, tileY) == TileType::Wall;
-    bool wallRight = Map::get().getTile(tileX + 1, tileY) == TileType::Wall;
+    bool wallUp = map.getTile(tileX, tileY - 1) == TileType::Wall;
+    bool wallDown = map.getTile(tileX, tileY + 1) == TileType::Wall;
+    bool wallLeft = map.getTile(tileX - 1, tileY) == TileType::Wall;
+    bool wallRight = map.getTile(tileX + 1, tileY) == TileType::Wall;
     
     int border = 2 * SCALE;
     
@@ -118,19 +147,20 @@ void Renderer::drawWallTile(int tileX, int tileY) {
     }
 }
 
-void Renderer::drawMaze() {
+void Renderer::drawMazeTiles(const Map& map, SDL_Color wall, SDL_Color door, int offsetY) {
     for (int y = 0; y < MAP_HEIGHT; y++) {
         for (int x = 0; x < MAP_WIDTH; x++) {
-            TileType tile = Map::get().getTile(x, y);
+            TileType tile = map.getTile(x, y);
             
             if (tile == TileType::Wall) {
-                drawWallTile(x, y);
+                SDL_SetRenderDrawColor(renderer, wall.r, wall.g, wall.b, 255);
+                drawWallTile(map, x, y, offsetY);
             }
             else if (tile == TileType::GhostDoor) {
-                SDL_SetRenderDrawColor(renderer, 255, 184, 222, 255);
+                SDL_SetRenderDrawColor(renderer, door.r, door.g, door.b, 255);
                 SDL_Rect rect = {
                     x * SCALED_TILE,
-                    y * SCALED_TILE + GAME_OFFSET_Y + SCALED_TILE / 3,
+                    y * SCALED_TILE + offsetY + SCALED_TILE / 3,
                     SCALED_TILE,
                     SCALED_TILE / 3
                 };
@@ -140,88 +170,223 @@ void Renderer::drawMaze() {
     }
 }
 
-void Renderer::drawMazeFlashing(bool whiteState) {
-    // Color: azul normal o blanco
-    Uint8 r, g, b;
-    if (whiteState) {
-        r = 255; g = 255; b = 255;  // Blanco
-    } else {
-        r = 33; g = 33; b = 222;    // Azul normal
+// Textura del tamaño del área de juego, transparente, para usar como render target
+SDL_Texture* Renderer::createLayerTexture(const char* name) {
+    SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                             MAP_WIDTH * SCALED_TILE, MAP_HEIGHT * SCALED_TILE);
+    if (!texture) {
+        std::cerr << name << " texture creation failed: " << SDL_GetError() << std::endl;
+        return nullptr;
     }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    return texture;
+}
+
+// Colores del laberinto
+static const SDL_Color MAZE_BLUE = {33, 33, 222, 255};
+static const SDL_Color MAZE_WHITE = {255, 255, 255, 255};
+static const SDL_Color DOOR_PINK = {255, 184, 222, 255};
+
+bool Renderer::updateMazeCache(const Map& map) {
+    if (mazeCacheFailed)
+        return false;
     
-    for (int y = 0; y < MAP_HEIGHT; y++) {
-        for (int x = 0; x < MAP_WIDTH; x++) {
-            TileType tile = Map::get().getTile(x, y);
-            
-            if (tile == TileType::Wall) {
-                SDL_SetRenderDrawColor(renderer, r, g, b, 255);
-                
-                int px = x * SCALED_TILE;
-                int py = y * SCALED_TILE + GAME_OFFSET_Y;
-                
-                bool wallUp = Map::get().getTile(x, y - 1) == TileType::Wall;
-                bool wallDown = Map::get().getTile(x, y + 1) == TileType::Wall;
-                bool wallLeft = Map::get().getTile(x - 1, y) == TileType::Wall;
-                bool wallRight = Map::get().getTile(x + 1, y) == TileType::Wall;
-                
-                int border = 2 * SCALE;
-                
-                if (!wallUp) {
-                    SDL_Rect rect = {px, py, SCALED_TILE, border};
-                    SDL_RenderFillRect(renderer, &rect);
-                }
-                if (!wallDown) {
-                    SDL_Rect rect = {px, py + SCALED_TILE - border, SCALED_TILE, border};
-                    SDL_RenderFillRect(renderer, &rect);
-                }
-                if (!wallLeft) {
-                    SDL_Rect rect = {px, py, border, SCALED_TILE};
-                    SDL_RenderFillRect(renderer, &rect);
-                }
-                if (!wallRight) {
-                    SDL_Rect rect = {px + SCALED_TILE - border, py, border, SCALED_TILE};
-                    SDL_RenderFillRect(renderer, &rect);
-                }
-            }
-            else if (tile == TileType::GhostDoor) {
-                // Puerta también parpadea
-                SDL_SetRenderDrawColor(renderer, r, g, b, 255);
-                SDL_Rect rect = {
-                    x * SCALED_TILE,
-                    y * SCALED_TILE + GAME_OFFSET_Y + SCALED_TILE / 3,
-                    SCALED_TILE,
-                    SCALED_TILE / 3
-                };
-                SDL_RenderFillRect(renderer, &rect);
+    // Las paredes y la puerta son lo único que se dibuja del laberinto
+    const MapLayers& layers = map.getLayers();
+    if (mazeCacheValid &&
+        std::memcmp(cachedWalls, layers.walls, sizeof(cachedWalls)) == 0 &&
+        std::memcmp(cachedDoor, layers.door, sizeof(cachedDoor)) == 0)
+        return true;
+    
+    if (!SDL_RenderTargetSupported(renderer)) {
+        mazeCacheFailed = true;
+        return false;
+    }
+    
+    for (SDL_Texture*& texture : mazeTextures) {
+        if (!texture) texture = createLayerTexture("Maze");
+        if (!texture) {
+            destroyMazeCache();
+            mazeCacheFailed = true;
+            return false;
+        }
+    }
+    
+    // Fondo transparente: el laberinto se copia encima de lo que haya
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+    for (int variant = 0; variant < MAZE_VARIANTS; variant++) {
+        SDL_SetRenderTarget(renderer, mazeTextures[variant]);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        SDL_RenderClear(renderer);
+        if (variant == MAZE_NORMAL) {
+            drawMazeTiles(map, MAZE_BLUE, DOOR_PINK, 0);
+        } else {
+            drawMazeTiles(map, MAZE_WHITE, MAZE_WHITE, 0);
+        }
+    }
+    SDL_SetRenderTarget(renderer, previousTarget);
+    
+    std::memcpy(cachedWalls, layers.walls, sizeof(cachedWalls));
+    std::memcpy(cachedDoor, layers.door, sizeof(cachedDoor));
+    mazeCacheValid = true;
+    return true;
+}
+
+void Renderer::destroyMazeCache() {
+    for (SDL_Texture*& texture : mazeTextures) {
+        if (texture) {
+            SDL_DestroyTexture(texture);
+            texture = nullptr;
+        }
+    }
+    mazeCacheValid = false;
+}
+
+void Renderer::invalidateCaches() {
+    destroyMazeCache();
+    destroyDotCache();
+}
+
+void Renderer::drawMaze(const Map& map) {
+    PROFILE_ZONE("Renderer::drawMaze");
+    TextureManager::get().flush();
+    if (!updateMazeCache(map)) {
+        drawMazeTiles(map, MAZE_BLUE, DOOR_PINK, GAME_OFFSET_Y);
+        return;
+    }
+    
+    SDL_Rect dst = {0, GAME_OFFSET_Y, MAP_WIDTH * SCALED_TILE, MAP_HEIGHT * SCALED_TILE};
+    SDL_RenderCopy(renderer, mazeTextures[MAZE_NORMAL], nullptr, &dst);
+}
+
+void Renderer::drawMazeFlashing(const Map& map, bool whiteState) {
+    // Color: azul normal o blanco (la puerta también parpadea)
+    SDL_Color color = whiteState ? MAZE_WHITE : MAZE_BLUE;
+    TextureManager::get().flush();
+    if (!updateMazeCache(map)) {
+        drawMazeTiles(map, color, color, GAME_OFFSET_Y);
+        return;
+    }
+    
+    SDL_Rect dst = {0, GAME_OFFSET_Y, MAP_WIDTH * SCALED_TILE, MAP_HEIGHT * SCALED_TILE};
+    SDL_SetTextureColorMod(mazeTextures[MAZE_FLASH], color.r, color.g, color.b);
+    SDL_RenderCopy(renderer, mazeTextures[MAZE_FLASH], nullptr, &dst);
+}
+
+// Dot normal: pequeño y centrado (6x6 píxeles)
+static constexpr int DOT_SIZE = 2 * SCALE;
+static constexpr int DOT_OFFSET = (SCALED_TILE - DOT_SIZE) / 2;
+
+// Power pellet: más grande pero no todo el tile (18x18 píxeles)
+static constexpr int PELLET_SIZE = 6 * SCALE;
+static constexpr int PELLET_OFFSET = (SCALED_TILE - PELLET_SIZE) / 2;
+
+bool Renderer::updateDotCache(const Map& map) {
+    if (dotCacheFailed)
+        return false;
+    
+    const MapLayers& layers = map.getLayers();
+    
+    // Un dot que no estaba (nivel nuevo, snapshot restaurado) obliga a rearmar
+    // la capa; si no, solo se borran los que faltan
+    bool rebuild = !dotCacheValid;
+    bool eaten = false;
+    for (int y = 0; y < MAP_HEIGHT && !rebuild; y++) {
+        if (layers.dots[y] & ~cachedDots[y]) rebuild = true;
+        if (cachedDots[y] & ~layers.dots[y]) eaten = true;
+    }
+    if (!rebuild && !eaten)
+        return true;
+    
+    if (!dotTexture) {
+        if (!SDL_RenderTargetSupported(renderer) || !(dotTexture = createLayerTexture("Dot"))) {
+            dotCacheFailed = true;
+            return false;
+        }
+    }
+    
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+    SDL_SetRenderTarget(renderer, dotTexture);
+    
+    if (rebuild) {
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        SDL_RenderClear(renderer);
+        
+        // Todos los dots en un lote, enviado antes de volver al target anterior
+        TextureManager& tm = TextureManager::get();
+        if (dotSprite) {
+            map.forEachDot([&](int x, int y) {
+                tm.draw(*dotSprite, x * SCALED_TILE + DOT_OFFSET, y * SCALED_TILE + DOT_OFFSET, DOT_SIZE, DOT_SIZE);
+            });
+            tm.flush();
+        }
+    }
+    else {
+        // Borrar (a transparente) los tiles comidos desde el frame anterior.
+        // Con mezcla un relleno de alfa 0 no cambiaría nada: escribir sin mezcla.
+        SDL_BlendMode previousBlend = SDL_BLENDMODE_NONE;
+        SDL_GetRenderDrawBlendMode(renderer, &previousBlend);
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+        SDL_Rect rects[MAP_WIDTH];
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        for (int y = 0; y < MAP_HEIGHT; y++) {
+            uint32_t bits = cachedDots[y] & ~layers.dots[y];
+            int count = 0;
+            while (bits) {
+                int x = lowestBit32(bits);
+                rects[count++] = {x * SCALED_TILE + DOT_OFFSET, y * SCALED_TILE + DOT_OFFSET, DOT_SIZE, DOT_SIZE};
+                bits &= bits - 1;
             }
+            if (count > 0) SDL_RenderFillRects(renderer, rects, count);
         }
+        SDL_SetRenderDrawBlendMode(renderer, previousBlend);
+    }
+    
+    SDL_SetRenderTarget(renderer, previousTarget);
+    std::memcpy(cachedDots, layers.dots, sizeof(cachedDots));
+    dotCacheValid = true;
+    return true;
+}
+
+void Renderer::destroyDotCache() {
+    if (dotTexture) {
+        SDL_DestroyTexture(dotTexture);
+        dotTexture = nullptr;
     }
+    dotCacheValid = false;
+}
+
+void Renderer::setDotSprites(const Sprite* dot, const Sprite* pellet) {
+    dotSprite = dot;
+    pelletSprite = pellet;
+    dotCacheValid = false;
 }
 
-void Renderer::drawDots() {
+void Renderer::drawDots(const Map& map) {
+    PROFILE_ZONE("Renderer::drawDots");
     auto& tm = TextureManager::get();
+    tm.flush();
     
-    for (int y = 0; y < MAP_HEIGHT; y++) {
-        for (int x = 0; x < MAP_WIDTH; x++) {
-            TileType tile = Map::get().getTile(x, y);
-            
+    if (updateDotCache(map)) {
+        SDL_Rect dst = {0, GAME_OFFSET_Y, MAP_WIDTH * SCALED_TILE, MAP_HEIGHT * SCALED_TILE};
+        SDL_RenderCopy(renderer, dotTexture, nullptr, &dst);
+    }
+    else if (dotSprite) {
+        // Sin render targets: un draw por dot que queda (bitboards del mapa)
+        map.forEachDot([&](int x, int y) {
             int px = x * SCALED_TILE;
             int py = y * SCALED_TILE + GAME_OFFSET_Y;
-            
-            if (tile == TileType::Dot) {
-                // Dot normal: pequeño y centrado (6x6 píxeles)
-                int dotSize = 2 * SCALE;  // 6 píxeles
-                int offset = (SCALED_TILE - dotSize) / 2;
-                tm.draw("pill", px + offset, py + offset, dotSize, dotSize);
-            }
-            else if (tile == TileType::PowerPellet) {
-                // Power pellet: más grande pero no todo el tile (18x18 píxeles)
-                int pelletSize = 6 * SCALE;  // 18 píxeles
-                int offset = (SCALED_TILE - pelletSize) / 2;
-                tm.draw("super_pill", px + offset, py + offset, pelletSize, pelletSize);
-            }
-        }
+            tm.draw(*dotSprite, px + DOT_OFFSET, py + DOT_OFFSET, DOT_SIZE, DOT_SIZE);
+        });
     }
+    
+    // Power pellets encima de la capa (si parpadearan, solo cambia este paso)
+    if (!pelletSprite)
+        return;
+    map.forEachPowerPellet([&](int x, int y) {
+        tm.draw(*pelletSprite, x * SCALED_TILE + PELLET_OFFSET, y * SCALED_TILE + GAME_OFFSET_Y + PELLET_OFFSET,
+                PELLET_SIZE, PELLET_SIZE);
+    });
 }
 
 void Renderer::drawNumber(int number, int x, int y) {
@@ -242,8 +407,12 @@ void Renderer::drawNumber(int number, int x, int y) {
 }
 
 void Renderer::drawScore(int score, int highScore, int /*lives*/, bool blinkScore) {
+    PROFILE_ZONE("Renderer::drawScore");
     if (!font) return;
     
+    // El texto TTF se dibuja fuera del lote de sprites
+    TextureManager::get().flush();
+    
     SDL_Color white = {255, 255, 255, 255};
     SDL_Color yellow = {255, 255, 0, 255};
     
@@ -310,31 +479,6 @@ void Renderer::drawScore(int score, int highScore, int /*lives*/, bool blinkScor
     }
 }
 
-void Renderer::drawLives(int lives) {
-    auto& tm = TextureManager::get();
-    
-    int y = SCREEN_HEIGHT - 2 * SCALED_TILE;
-    
-    for (int i = 0; i < lives - 1; i++) {
-        int x = (2 + i * 2) * SCALED_TILE;
-        tm.draw("pacman_life", x, y, SCALED_TILE * 13 / 8, SCALED_TILE * 13 / 8);
-    }
-}
-
-void Renderer::drawFruit() {
-    auto& tm = TextureManager::get();
-    tm.draw("cherry", SCREEN_WIDTH - 3 * SCALED_TILE, 
-            SCREEN_HEIGHT - 2 * SCALED_TILE, 
-            SCALED_TILE * 13 / 8, SCALED_TILE * 13 / 8);
-}
-
-void Renderer::drawText(const std::string& textureId, int x, int y) {
-    auto& tm = TextureManager::get();
-    SDL_Texture* tex = tm.getTexture(textureId);
-    
-    if (tex) {
-        int w, h;
-        SDL_QueryTexture(tex, nullptr, nullptr, &w, &h);
-        tm.draw(textureId, x, y, w * SCALE, h * SCALE);
-    }
+void Renderer::drawText(const Sprite& sprite, int x, int y) {
+    TextureManager::get().draw(sprite, x, y, sprite.src.w * SCALE, sprite.src.h * SCALE);
 }
\ No newline at end of file
@@ -4,14 +4,21 @@
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
+#include "Constants.h"
+#include <cstdint>
 #include <string>
 
+struct Sprite;
+
+class Map;
+
 class Renderer {
 public:
     Renderer();
     ~Renderer();
     
     bool init();
+    bool initOffscreen();  // Sin ventana: dibuja en una superficie en memoria (benchmarks)
     void shutdown();
     
     // Frame
@@ -19,22 +26,55 @@ public:
     void present();
     
     // Dibujar
-    void drawMaze();                        // Dibujar laberinto con código
-    void drawMazeFlashing(bool whiteState); // Para animación Level Clear
-    void drawDots();
+    void drawMaze(const Map& map);                          // Dibujar laberinto con código
+    void drawMazeFlashing(const Map& map, bool whiteState); // Para animación Level Clear
+    void drawDots(const Map& map);
     void drawScore(int score, int highScore, int lives, bool blinkScore = false);
-    void drawText(const std::string& textureId, int x, int y);
-    void drawLives(int lives);
-    void drawFruit();
+    void drawText(const Sprite& sprite, int x, int y);  // Tamaño del sprite x SCALE
+    
+    // Sprites de dots y power pellets (después de armar el atlas; hasta
+    // entonces drawDots no dibuja dots)
+    void setDotSprites(const Sprite* dot, const Sprite* pellet);
+    
+    // Descartar las texturas pre-renderizadas (SDL_RENDER_TARGETS_RESET /
+    // SDL_RENDER_DEVICE_RESET); se reconstruyen en el próximo frame
+    void invalidateCaches();
     
     // Acceso al renderer SDL
     SDL_Renderer* getSDLRenderer() const { return renderer; }
-    
+
 private:
     SDL_Window* window = nullptr;
     SDL_Renderer* renderer = nullptr;
+    SDL_Surface* target = nullptr;  // Solo en modo offscreen
     TTF_Font* font = nullptr;
     
+    // Laberinto pre-renderizado: uno con la puerta rosa y otro todo en
+    // blanco que drawMazeFlashing tiñe (color mod) de azul o blanco.
+    // Se reconstruye solo si cambian las paredes o la puerta del mapa.
+    enum MazeVariant { MAZE_NORMAL, MAZE_FLASH, MAZE_VARIANTS };
+    SDL_Texture* mazeTextures[MAZE_VARIANTS] = {nullptr, nullptr};
+    uint32_t cachedWalls[MAP_HEIGHT] = {};
+    uint32_t cachedDoor[MAP_HEIGHT] = {};
+    bool mazeCacheValid = false;
+    bool mazeCacheFailed = false;  // Sin render targets: se dibuja como antes
+    
+    // Capa de dots: se arma al empezar el nivel (o si reaparecen dots) y
+    // después solo se borran los tiles comidos. Los power pellets van
+    // aparte, dibujados encima en cada frame (como mucho 4).
+    SDL_Texture* dotTexture = nullptr;
+    uint32_t cachedDots[MAP_HEIGHT] = {};
+    bool dotCacheValid = false;
+    bool dotCacheFailed = false;
+    const Sprite* dotSprite = nullptr;
+    const Sprite* pelletSprite = nullptr;
+    
     void drawNumber(int number, int x, int y);
-    void drawWallTile(int x, int y);
+    void drawMazeTiles(const Map& map, SDL_Color wall, SDL_Color door, int offsetY);
+    void drawWallTile(const Map& map, int x, int y, int offsetY);
+    SDL_Texture* createLayerTexture(const char* name);
+    bool updateMazeCache(const Map& map);
+    void destroyMazeCache();
+    bool updateDotCache(const Map& map);
+    void destroyDotCache();
 };
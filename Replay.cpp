@@ -0,0 +1,213 @@
+// Replay.cpp
+#include "Replay.h"
+#include "GameCore.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+// Cabecera: "PMRP", versión, semilla (u32 LE), nivel, largo y cantidad (varint)
+static const char REPLAY_MAGIC[4] = {'P', 'M', 'R', 'P'};
+static constexpr uint8_t REPLAY_VERSION = 1;
+
+// Log de hashes: "PMHL", versión y relleno hasta 8 bytes; después un u64 LE por tick
+static const char HASHLOG_MAGIC[4] = {'P', 'M', 'H', 'L'};
+static constexpr uint8_t HASHLOG_VERSION = 1;
+static constexpr size_t HASHLOG_HEADER_SIZE = 8;
+
+static void writeVarint(std::vector<uint8_t>& out, uint32_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+static bool readVarint(const std::vector<uint8_t>& in, size_t& pos, uint32_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (pos >= in.size())
+            return false;
+        uint8_t b = in[pos++];
+        v |= static_cast<uint32_t>(b & 0x7F) << shift;
+        if (!(b & 0x80))
+            return true;
+    }
+    return false;
+}
+
+void Replay::begin(uint32_t s, int lvl) {
+    seed = s;
+    level = lvl;
+    length = 0;
+    inputs.clear();
+}
+
+void Replay::record(uint32_t tick, PlayerAction action) {
+    inputs.push_back({tick, action});
+    if (tick > length) length = tick;
+}
+
+std::vector<uint8_t> Replay::encode() const {
+    std::vector<uint8_t> out(REPLAY_MAGIC, REPLAY_MAGIC + 4);
+    out.push_back(REPLAY_VERSION);
+    for (int i = 0; i < 4; i++) {
+        out.push_back(static_cast<uint8_t>(seed >> (8 * i)));
+    }
+    writeVarint(out, static_cast<uint32_t>(level));
+    writeVarint(out, length);
+    writeVarint(out, static_cast<uint32_t>(inputs.size()));
+    
+    // Delta de ticks respecto de la entrada anterior
+    uint32_t prevTick = 0;
+    for (const ReplayInput& in : inputs) {
+        writeVarint(out, in.tick - prevTick);
+        out.push_back(static_cast<uint8_t>(in.action));
+        prevTick = in.tick;
+    }
+    return out;
+}
+
+bool Replay::decode(const std::vector<uint8_t>& data) {
+    if (data.size() < 9 || !std::equal(REPLAY_MAGIC, REPLAY_MAGIC + 4, data.begin()) ||
+        data[4] != REPLAY_VERSION)
+        return false;
+    
+    uint32_t s = 0;
+    for (int i = 0; i < 4; i++) {
+        s |= static_cast<uint32_t>(data[5 + i]) << (8 * i);
+    }
+    
+    size_t pos = 9;
+    uint32_t lvl, len, count;
+    if (!readVarint(data, pos, lvl) || !readVarint(data, pos, len) || !readVarint(data, pos, count))
+        return false;
+    
+    // Cada entrada ocupa al menos 2 bytes: no reservar según un count imposible
+    if (count > (data.size() - pos) / 2)
+        return false;
+    
+    std::vector<ReplayInput> decoded;
+    decoded.reserve(count);
+    
+    uint32_t tick = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t delta;
+        if (!readVarint(data, pos, delta) || pos >= data.size())
+            return false;
+        
+        uint8_t action = data[pos++];
+        if (action > static_cast<uint8_t>(PlayerAction::Resume))
+            return false;
+        
+        tick += delta;
+        decoded.push_back({tick, static_cast<PlayerAction>(action)});
+    }
+    
+    // Bytes sobrantes: archivo truncado en otro lugar o corrupto
+    if (pos != data.size())
+        return false;
+    
+    seed = s;
+    level = static_cast<int>(lvl);
+    length = len;
+    inputs = std::move(decoded);
+    return true;
+}
+
+bool Replay::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open())
+        return false;
+    
+    std::vector<uint8_t> data = encode();
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return file.good();
+}
+
+bool Replay::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+        return false;
+    
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return decode(data);
+}
+
+void applyPlayerAction(GameCore& core, PlayerAction action) {
+    switch (action) {
+        case PlayerAction::Up:      core.setDesiredDirection(Direction::Up); break;
+        case PlayerAction::Down:    core.setDesiredDirection(Direction::Down); break;
+        case PlayerAction::Left:    core.setDesiredDirection(Direction::Left); break;
+        case PlayerAction::Right:   core.setDesiredDirection(Direction::Right); break;
+        case PlayerAction::Start:   core.startGame(); break;
+        case PlayerAction::NewGame: core.newGame(); break;
+        case PlayerAction::Pause:   core.pause(); break;
+        case PlayerAction::Resume:  core.resume(); break;
+    }
+}
+
+// ===== HASH LOG =====
+
+std::vector<uint64_t> computeHashLog(const Replay& replay) {
+    GameCore core(replay.seed);
+    core.setStartLevel(replay.level);
+    ReplayPlayer player(replay);
+    
+    std::vector<uint64_t> log;
+    log.reserve(replay.length);
+    
+    while (!player.isFinished(core.getTick())) {
+        player.applyDue(core.getTick(), [&core](PlayerAction a) { applyPlayerAction(core, a); });
+        core.update();
+        log.push_back(core.getHash());
+    }
+    return log;
+}
+
+bool saveHashLog(const std::string& path, const std::vector<uint64_t>& log) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open())
+        return false;
+    
+    std::vector<uint8_t> data(HASHLOG_MAGIC, HASHLOG_MAGIC + 4);
+    data.push_back(HASHLOG_VERSION);
+    data.resize(HASHLOG_HEADER_SIZE, 0);
+    for (uint64_t hash : log) {
+        for (int i = 0; i < 8; i++) {
+            data.push_back(static_cast<uint8_t>(hash >> (8 * i)));
+        }
+    }
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return file.good();
+}
+
+bool loadHashLog(const std::string& path, std::vector<uint64_t>& log) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+        return false;
+    
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (data.size() < HASHLOG_HEADER_SIZE || data.size() % 8 != 0 ||
+        !std::equal(HASHLOG_MAGIC, HASHLOG_MAGIC + 4, data.begin()) || data[4] != HASHLOG_VERSION)
+        return false;
+    
+    log.clear();
+    log.reserve((data.size() - HASHLOG_HEADER_SIZE) / 8);
+    for (size_t pos = HASHLOG_HEADER_SIZE; pos < data.size(); pos += 8) {
+        uint64_t hash = 0;
+        for (int i = 0; i < 8; i++) {
+            hash |= static_cast<uint64_t>(data[pos + i]) << (8 * i);
+        }
+        log.push_back(hash);
+    }
+    return true;
+}
+
+long findDivergence(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b) {
+    size_t n = std::min(a.size(), b.size());
+    for (size_t i = 0; i < n; i++) {
+        if (a[i] != b[i])
+            return static_cast<long>(i) + 1;
+    }
+    return -1;
+}
@@ -0,0 +1,82 @@
+// Replay.h
+// Grabación y reproducción de partidas (entradas indexadas por tick)
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class GameCore;
+
+// Entradas que afectan a la simulación
+enum class PlayerAction : uint8_t {
+    Up,
+    Down,
+    Left,
+    Right,
+    Start,     // PressStart -> Startup
+    NewGame,   // Reiniciar después de Game Over
+    Pause,
+    Resume
+};
+
+struct ReplayInput {
+    uint32_t tick;         // GameCore::getTick() al aplicar la entrada
+    PlayerAction action;
+};
+
+// Partida grabada: semilla, nivel inicial y solo los cambios de entrada.
+// En disco cada entrada es un delta de ticks (varint) + 1 byte de acción,
+// así una partida completa ocupa pocos KB.
+class Replay {
+public:
+    uint32_t seed = 0;
+    int level = 1;
+    uint32_t length = 0;   // Ticks grabados
+    std::vector<ReplayInput> inputs;
+    
+    // Grabación: solo entradas que cambiaron el estado (ver GameCore::setDesiredDirection)
+    void begin(uint32_t seed, int level);
+    void record(uint32_t tick, PlayerAction action);
+    void finish(uint32_t tick) { length = tick; }
+    
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+    
+    std::vector<uint8_t> encode() const;
+    bool decode(const std::vector<uint8_t>& data);
+};
+
+// Reproduce un Replay sobre un GameCore: antes de cada update se aplican
+// las entradas de ese tick
+class ReplayPlayer {
+public:
+    explicit ReplayPlayer(const Replay& replay) : replay(replay) {}
+    
+    // fn(PlayerAction) por cada entrada del tick actual
+    template <typename Fn>
+    void applyDue(uint32_t tick, Fn&& fn) {
+        while (cursor < replay.inputs.size() && replay.inputs[cursor].tick <= tick) {
+            fn(replay.inputs[cursor].action);
+            cursor++;
+        }
+    }
+    
+    bool isFinished(uint32_t tick) const { return tick >= replay.length; }
+
+private:
+    const Replay& replay;
+    size_t cursor = 0;
+};
+
+// Aplica una entrada directamente al núcleo (sin audio; modo headless)
+void applyPlayerAction(GameCore& core, PlayerAction action);
+
+// Log de hashes: GameCore::getHash() después de cada tick (índice = tick - 1).
+// Dos builds o máquinas que reproducen el mismo replay deben dar el mismo log.
+std::vector<uint64_t> computeHashLog(const Replay& replay);
+bool saveHashLog(const std::string& path, const std::vector<uint64_t>& log);
+bool loadHashLog(const std::string& path, std::vector<uint64_t>& log);
+
+// Primer tick con hash distinto (-1 si coinciden hasta el final del más corto)
+long findDivergence(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b);
@@ -1,7 +1,15 @@
 // TextureManager.cpp
 #include "TextureManager.h"
+#include <algorithm>
 #include <iostream>
 
+// Separación entre sprites del atlas (evita que el filtrado mezcle vecinos)
+static constexpr int ATLAS_PADDING = 1;
+static constexpr int ATLAS_MAX_WIDTH = 4096;
+
+// Capacidad inicial del lote (sprites por frame sin reasignar)
+static constexpr size_t BATCH_RESERVE = 256;
+
 TextureManager& TextureManager::get() {
     static TextureManager instance;
     return instance;
@@ -9,7 +17,12 @@ TextureManager& TextureManager::get() {
 
 bool TextureManager::init(SDL_Renderer* r) {
     renderer = r;
-    
+
+#if TEXTURE_BATCHING
+    batchVertices.reserve(BATCH_RESERVE * 4);
+    batchIndices.reserve(BATCH_RESERVE * 6);
+#endif
+
     int imgFlags = IMG_INIT_PNG;
     if (!(IMG_Init(imgFlags) & imgFlags)) {
         std::cerr << "SDL_image init failed: " << IMG_GetError() << std::endl;
@@ -25,53 +38,239 @@ void TextureManager::shutdown() {
 }
 
 bool TextureManager::load(const std::string& id, const std::string& path) {
-    SDL_Surface* surface = IMG_Load(path.c_str());
-    if (!surface) {
+    SDL_Surface* loaded = IMG_Load(path.c_str());
+    if (!loaded) {
         std::cerr << "Failed to load image: " << path << " - " << IMG_GetError() << std::endl;
         return false;
     }
     
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_FreeSurface(surface);
+    // Un solo formato para poder girar y empaquetar los píxeles
+    SDL_Surface* surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(loaded);
+    if (!surface) {
+        std::cerr << "Failed to convert image: " << path << " - " << SDL_GetError() << std::endl;
+        return false;
+    }
     
+    return addSurface(id, surface);
+}
+
+// Crea la textura suelta del sprite y se queda con la superficie (para el atlas)
+bool TextureManager::addSurface(const std::string& id, SDL_Surface* surface) {
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
     if (!texture) {
         std::cerr << "Failed to create texture: " << SDL_GetError() << std::endl;
+        SDL_FreeSurface(surface);
         return false;
     }
     
-    textures[id] = texture;
+    auto old = surfaces.find(id);
+    if (old != surfaces.end()) SDL_FreeSurface(old->second);
+    surfaces[id] = surface;
+    
+    Sprite& sprite = sprites[id];
+    sprite.texture = texture;
+    sprite.src = {0, 0, surface->w, surface->h};
+    sprite.u0 = 0.0f;
+    sprite.v0 = 0.0f;
+    sprite.u1 = 1.0f;
+    sprite.v1 = 1.0f;
+    textures.push_back(texture);
     return true;
 }
 
-SDL_Texture* TextureManager::getTexture(const std::string& id) {
-    auto it = textures.find(id);
-    return (it != textures.end()) ? it->second : nullptr;
+bool TextureManager::addRotations(const std::string& id) {
+    auto it = surfaces.find(id);
+    if (it == surfaces.end())
+        return false;
+    
+    SDL_Surface* src = it->second;
+    if (SDL_MUSTLOCK(src)) SDL_LockSurface(src);
+    
+    static const char* suffixes[] = {"_90", "_180", "_270"};
+    bool ok = true;
+    for (int turns = 1; turns <= 3; turns++) {
+        int w = (turns == 2) ? src->w : src->h;
+        int h = (turns == 2) ? src->h : src->w;
+        SDL_Surface* dst = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_RGBA32);
+        if (!dst) {
+            ok = false;
+            continue;
+        }
+        
+        // Giro horario (igual que el ángulo de SDL_RenderCopyEx)
+        const Uint32* in = static_cast<const Uint32*>(src->pixels);
+        Uint32* out = static_cast<Uint32*>(dst->pixels);
+        int inPitch = src->pitch / 4;
+        int outPitch = dst->pitch / 4;
+        for (int y = 0; y < src->h; y++) {
+            for (int x = 0; x < src->w; x++) {
+                int ox, oy;
+                if (turns == 1)      { ox = src->h - 1 - y; oy = x; }
+                else if (turns == 2) { ox = src->w - 1 - x; oy = src->h - 1 - y; }
+                else                 { ox = y;              oy = src->w - 1 - x; }
+                out[oy * outPitch + ox] = in[y * inPitch + x];
+            }
+        }
+        
+        ok = addSurface(id + suffixes[turns - 1], dst) && ok;
+    }
+    
+    if (SDL_MUSTLOCK(src)) SDL_UnlockSurface(src);
+    return ok;
 }
 
-void TextureManager::draw(const std::string& id, int x, int y, int w, int h,
-                          double angle, SDL_RendererFlip flip) {
-    SDL_Texture* tex = getTexture(id);
-    if (!tex) return;
+bool TextureManager::buildAtlas() {
+    if (surfaces.empty())
+        return false;
+    
+    // Estantes: de más alto a más bajo, de izquierda a derecha
+    std::vector<std::pair<const std::string*, SDL_Surface*>> order;
+    for (auto& pair : surfaces) order.emplace_back(&pair.first, pair.second);
+    std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) {
+        if (a.second->h != b.second->h) return a.second->h > b.second->h;
+        return *a.first < *b.first;
+    });
     
+    std::vector<SDL_Rect> placed(order.size());
+    int width = 256;
+    int height = 0;
+    for (;;) {
+        int x = 0, y = 0, shelf = 0;
+        bool fits = true;
+        for (size_t i = 0; i < order.size(); i++) {
+            int w = order[i].second->w + ATLAS_PADDING;
+            int h = order[i].second->h + ATLAS_PADDING;
+            if (w > width) {
+                fits = false;
+                break;
+            }
+            if (x + w > width) {
+                x = 0;
+                y += shelf;
+                shelf = 0;
+            }
+            placed[i] = {x, y, order[i].second->w, order[i].second->h};
+            x += w;
+            shelf = std::max(shelf, h);
+        }
+        height = y + shelf;
+        
+        // Preferir un atlas más o menos cuadrado
+        if (fits && height <= width)
+            break;
+        if (width >= ATLAS_MAX_WIDTH) {
+            if (fits) break;
+            std::cerr << "Sprite atlas does not fit, keeping separate textures" << std::endl;
+            return false;
+        }
+        width *= 2;
+    }
+    
+    SDL_Surface* atlasSurface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!atlasSurface) {
+        std::cerr << "Sprite atlas creation failed: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    
+    // Copia exacta (con alfa) sobre el atlas transparente
+    for (size_t i = 0; i < order.size(); i++) {
+        SDL_SetSurfaceBlendMode(order[i].second, SDL_BLENDMODE_NONE);
+        SDL_Rect dst = placed[i];
+        SDL_BlitSurface(order[i].second, nullptr, atlasSurface, &dst);
+    }
+    
+    SDL_Texture* atlas = SDL_CreateTextureFromSurface(renderer, atlasSurface);
+    SDL_FreeSurface(atlasSurface);
+    if (!atlas) {
+        std::cerr << "Sprite atlas texture creation failed: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+    
+    flush();
+    for (SDL_Texture* texture : textures) SDL_DestroyTexture(texture);
+    textures.assign(1, atlas);
+    
+    for (size_t i = 0; i < order.size(); i++) {
+        Sprite& sprite = sprites[*order[i].first];
+        sprite.texture = atlas;
+        sprite.src = placed[i];
+        sprite.u0 = static_cast<float>(placed[i].x) / width;
+        sprite.v0 = static_cast<float>(placed[i].y) / height;
+        sprite.u1 = static_cast<float>(placed[i].x + placed[i].w) / width;
+        sprite.v1 = static_cast<float>(placed[i].y + placed[i].h) / height;
+    }
+    
+    return true;
+}
+
+const Sprite* TextureManager::getSprite(const std::string& id) const {
+    auto it = sprites.find(id);
+    return (it != sprites.end()) ? &it->second : nullptr;
+}
+
+void TextureManager::draw(const Sprite& sprite, int x, int y, int w, int h) {
     SDL_Rect dst = {x, y, w, h};
-    SDL_RenderCopyEx(renderer, tex, nullptr, &dst, angle, nullptr, flip);
+    queue(sprite, dst);
 }
 
-void TextureManager::drawFrame(const std::string& id, int x, int y, int w, int h,
-                               int frameX, int frameY, int frameW, int frameH) {
-    SDL_Texture* tex = getTexture(id);
-    if (!tex) return;
+void TextureManager::queue(const Sprite& sprite, const SDL_Rect& dst) {
+#if TEXTURE_BATCHING
+    if (sprite.texture != batchTexture) {
+        flush();
+        batchTexture = sprite.texture;
+    }
     
-    SDL_Rect src = {frameX, frameY, frameW, frameH};
-    SDL_Rect dst = {x, y, w, h};
-    SDL_RenderCopy(renderer, tex, &src, &dst);
+    // Dos triángulos por sprite
+    int base = static_cast<int>(batchVertices.size());
+    float x0 = static_cast<float>(dst.x);
+    float y0 = static_cast<float>(dst.y);
+    float x1 = static_cast<float>(dst.x + dst.w);
+    float y1 = static_cast<float>(dst.y + dst.h);
+    SDL_Color white = {255, 255, 255, 255};
+    batchVertices.push_back({{x0, y0}, white, {sprite.u0, sprite.v0}});
+    batchVertices.push_back({{x1, y0}, white, {sprite.u1, sprite.v0}});
+    batchVertices.push_back({{x1, y1}, white, {sprite.u1, sprite.v1}});
+    batchVertices.push_back({{x0, y1}, white, {sprite.u0, sprite.v1}});
+    const int corners[] = {0, 1, 2, 0, 2, 3};
+    for (int corner : corners) batchIndices.push_back(base + corner);
+#else
+    SDL_RenderCopy(renderer, sprite.texture, &sprite.src, &dst);
+#endif
+}
+
+void TextureManager::flush() {
+#if TEXTURE_BATCHING
+    if (!batchVertices.empty()) {
+        SDL_RenderGeometry(renderer, batchTexture,
+                           batchVertices.data(), static_cast<int>(batchVertices.size()),
+                           batchIndices.data(), static_cast<int>(batchIndices.size()));
+        batchVertices.clear();
+        batchIndices.clear();
+    }
+    batchTexture = nullptr;
+#endif
+}
+
+void TextureManager::freeSurfaces() {
+    for (auto& pair : surfaces) SDL_FreeSurface(pair.second);
+    surfaces.clear();
 }
 
 void TextureManager::clear() {
-    for (auto& pair : textures) {
-        if (pair.second) {
-            SDL_DestroyTexture(pair.second);
+#if TEXTURE_BATCHING
+    batchVertices.clear();
+    batchIndices.clear();
+    batchTexture = nullptr;
+#endif
+
+    for (SDL_Texture* texture : textures) {
+        if (texture) {
+            SDL_DestroyTexture(texture);
         }
     }
     textures.clear();
+    sprites.clear();
+    freeSurfaces();
 }
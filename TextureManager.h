@@ -6,6 +6,24 @@
 #include <SDL2/SDL_image.h>
 #include <string>
 #include <unordered_map>
+#include <vector>
+
+// SDL_RenderGeometry existe desde SDL 2.0.18; antes se dibuja con SDL_RenderCopy
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+#define TEXTURE_BATCHING 1
+#else
+#define TEXTURE_BATCHING 0
+#endif
+
+// Sprite: región de una textura. Después de buildAtlas() todos los sprites
+// apuntan a la misma textura (el atlas) y los draws se acumulan en un solo
+// lote que se envía con SDL_RenderGeometry en flush().
+struct Sprite {
+    SDL_Texture* texture = nullptr;
+    SDL_Rect src = {0, 0, 0, 0};     // En píxeles de 'texture'
+    float u0 = 0.0f, v0 = 0.0f;      // Coordenadas normalizadas de src
+    float u1 = 0.0f, v1 = 0.0f;
+};
 
 class TextureManager {
 public:
@@ -15,22 +33,49 @@ public:
     void shutdown();
     
     bool load(const std::string& id, const std::string& path);
-    SDL_Texture* getTexture(const std::string& id);
     
-    // Dibujar textura
-    void draw(const std::string& id, int x, int y, int w, int h, 
-              double angle = 0.0, SDL_RendererFlip flip = SDL_FLIP_NONE);
+    // Copias giradas 90/180/270 grados (horario) de un sprite cargado:
+    // id + "_90", "_180", "_270". Evita rotar en cada frame.
+    bool addRotations(const std::string& id);
     
-    // Dibujar con source rect
-    void drawFrame(const std::string& id, int x, int y, int w, int h,
-                   int frameX, int frameY, int frameW, int frameH);
+    // Empaqueta todos los sprites cargados en una textura y libera las
+    // texturas sueltas. Si falla, se siguen usando las texturas sueltas.
+    // Se puede volver a llamar después de cargar más sprites.
+    bool buildAtlas();
     
-    void clear();
+    // nullptr si no existe (el puntero vale hasta clear()). Para resolver
+    // los sprites una vez al cargar: los frames dibujan con punteros.
+    const Sprite* getSprite(const std::string& id) const;
+    
+    // Dibujar sprite (se acumula en el lote)
+    void draw(const Sprite& sprite, int x, int y, int w, int h);
+    
+    // Envía el lote pendiente. Llamar antes de dibujar fuera del gestor
+    // (rectángulos, texto TTF, otras texturas), de cambiar el render target
+    // y de presentar.
+    void flush();
     
+    void clear();
+
 private:
     TextureManager() = default;
     ~TextureManager() = default;
     
     SDL_Renderer* renderer = nullptr;
-    std::unordered_map<std::string, SDL_Texture*> textures;
+    std::unordered_map<std::string, Sprite> sprites;
+    std::vector<SDL_Texture*> textures;  // Texturas propias (sueltas o el atlas)
+    
+    // Imágenes en RGBA32 (se conservan para rearmar el atlas si se cargan más)
+    std::unordered_map<std::string, SDL_Surface*> surfaces;
+
+#if TEXTURE_BATCHING
+    // Lote pendiente (una textura por lote)
+    SDL_Texture* batchTexture = nullptr;
+    std::vector<SDL_Vertex> batchVertices;
+    std::vector<int> batchIndices;
+#endif
+
+    bool addSurface(const std::string& id, SDL_Surface* surface);
+    void queue(const Sprite& sprite, const SDL_Rect& dst);
+    void freeSurfaces();
 };
@@ -0,0 +1,67 @@
+// WorkerPool.cpp
+#include "WorkerPool.h"
+#include <algorithm>
+
+WorkerPool::WorkerPool(int workers) {
+    if (workers <= 0) {
+        workers = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    
+    for (int i = 1; i < workers; i++) {
+        threads.emplace_back(&WorkerPool::workerLoop, this, i);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& t : threads) {
+        t.join();
+    }
+}
+
+void WorkerPool::run(const std::function<void(int)>& fn) {
+    if (threads.empty()) {
+        fn(0);
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        pending = static_cast<int>(threads.size());
+        generation++;
+    }
+    wake.notify_all();
+    
+    fn(0);
+    
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&] { return pending == 0; });
+    job = nullptr;
+}
+
+void WorkerPool::workerLoop(int index) {
+    uint64_t seen = 0;
+    for (;;) {
+        const std::function<void(int)>* fn;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+            fn = job;
+        }
+        
+        (*fn)(index);
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0) done.notify_one();
+        }
+    }
+}
@@ -0,0 +1,38 @@
+// WorkerPool.h
+// Pool fijo de hilos para repartir trabajo de simulación (sin SDL)
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// run(fn) ejecuta fn(índice) una vez en cada worker y espera a que terminen
+// todos. El hilo que llama es el worker 0, así con un solo worker no hay
+// cambios de contexto. Los hilos duermen entre llamadas.
+class WorkerPool {
+public:
+    explicit WorkerPool(int workers = 0);  // 0 = un worker por núcleo
+    ~WorkerPool();
+    
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    
+    int size() const { return static_cast<int>(threads.size()) + 1; }
+    
+    void run(const std::function<void(int)>& fn);
+
+private:
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void(int)>* job = nullptr;
+    uint64_t generation = 0;
+    int pending = 0;
+    bool stopping = false;
+    
+    void workerLoop(int index);
+};
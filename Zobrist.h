@@ -0,0 +1,28 @@
+// Zobrist.h
+// Claves de Zobrist para el hash del estado de la partida
+#pragma once
+
+#include <cstdint>
+
+// Cada rasgo del estado (un dot en (x, y), un fantasma en un tile con
+// cierta dirección y modo...) tiene una clave de 64 bits. El hash es el XOR
+// de las claves presentes: comer un dot es un solo XOR.
+enum class ZobristDomain : uint64_t {
+    Dot = 1,
+    Pellet,
+    Entity,
+    Scalar
+};
+
+// splitmix64: las claves se calculan en el momento (sin tablas) y son
+// iguales en todas las plataformas
+constexpr uint64_t zobristMix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+constexpr uint64_t zobristKey(ZobristDomain domain, uint64_t feature) {
+    return zobristMix((static_cast<uint64_t>(domain) << 56) ^ feature);
+}